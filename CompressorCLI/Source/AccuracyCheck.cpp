@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    AccuracyCheck.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AccuracyCheck.h"
+
+namespace
+{
+    struct TierResult
+    {
+        double worstErrorDecibels = 0.0;
+        double worstThreshold = 0.0, worstRatio = 1.0, worstLevel = 0.0;
+        double thresholdConversionErrorDecibels = 0.0;
+    };
+
+    /** Feeds one sample per input level through the compressor with zero attack and
+        release, so the envelope is |x| and every sample sees the static gain law,
+        then compares each gain with the exact law in double.
+    */
+    template <typename SampleType>
+    TierResult measureTier (typename ViatorCompressor<SampleType>::GainMath tier, double thresholdStep, double ratioStep, double levelStep)
+    {
+        std::vector<SampleType> levels, samples;
+
+        for (auto levelDecibels = -90.0; levelDecibels <= 30.0; levelDecibels += levelStep)
+            levels.push_back ((SampleType) juce::Decibels::decibelsToGain (levelDecibels, -200.0));
+
+        ViatorCompressor<SampleType> compressor;
+        compressor.prepare ({ 48000.0, (juce::uint32) levels.size(), 1 });
+        compressor.setAttack (0);
+        compressor.setRelease (0);
+        compressor.setGainMath (tier);
+
+        TierResult result;
+
+        for (auto threshold = -60.0; threshold <= 0.0; threshold += thresholdStep)
+        {
+            for (auto ratio = 1.0; ratio <= 10.0; ratio += ratioStep)
+            {
+                compressor.setThreshold ((SampleType) threshold);
+                compressor.setRatio ((SampleType) ratio);
+                compressor.reset(); // lands the threshold ramp, so the block sees this threshold throughout
+
+                samples = levels;
+                SampleType* channels[] = { samples.data() };
+                juce::dsp::AudioBlock<SampleType> block (channels, 1, samples.size());
+                compressor.process (juce::dsp::ProcessContextReplacing<SampleType> (block));
+
+                for (size_t i = 0; i < levels.size(); ++i)
+                {
+                    auto levelDecibels = juce::Decibels::gainToDecibels ((double) levels[i], -200.0);
+                    auto overshoot = juce::jmax (0.0, levelDecibels - threshold);
+                    auto expected = overshoot * (1.0 / ratio - 1.0);
+                    auto actual = juce::Decibels::gainToDecibels ((double) samples[i] / (double) levels[i], -200.0);
+                    auto error = std::abs (actual - expected);
+
+                    if (error > result.worstErrorDecibels)
+                        result = { error, threshold, ratio, levelDecibels, 0.0 };
+                }
+            }
+        }
+
+        // While the threshold ramps, the fast tier also converts it from dB per sample
+        if (tier == ViatorCompressor<SampleType>::GainMath::fast)
+        {
+            for (auto threshold = -60.0; threshold <= 0.0; threshold += 0.001)
+            {
+                auto inverse = (double) FastGainMath<SampleType>::inverseDecibelsToGain ((SampleType) threshold);
+                auto error = std::abs (juce::Decibels::gainToDecibels (inverse) + threshold);
+                result.thresholdConversionErrorDecibels = juce::jmax (result.thresholdConversionErrorDecibels, error);
+            }
+        }
+
+        return result;
+    }
+
+    template <typename SampleType>
+    bool checkTier (typename ViatorCompressor<SampleType>::GainMath tier, const juce::String& name, const CommandLine& commandLine)
+    {
+        auto result = measureTier<SampleType> (tier, commandLine.getDouble ("thresholdStep", 0.5),
+                                               commandLine.getDouble ("ratioStep", 0.25), commandLine.getDouble ("levelStep", 0.05));
+        auto bound = ViatorCompressor<SampleType>::getMaximumErrorDecibels (tier);
+        auto passed = result.worstErrorDecibels <= bound && result.thresholdConversionErrorDecibels <= bound;
+
+        std::cout << name.paddedRight (' ', 7) << (std::is_same<SampleType, float>::value ? "float " : "double")
+                  << juce::String (result.worstErrorDecibels, 7).paddedLeft (' ', 14)
+                  << juce::String (result.thresholdConversionErrorDecibels, 7).paddedLeft (' ', 14)
+                  << juce::String (bound, 7).paddedLeft (' ', 12) << "   "
+                  << (passed ? "ok" : "OVER") << "  (worst at threshold " << result.worstThreshold << " dB, ratio "
+                  << result.worstRatio << ", level " << juce::String (result.worstLevel, 2) << " dB)" << std::endl;
+
+        return passed;
+    }
+}
+
+//==============================================================================
+int runAccuracyCheck (const CommandLine& commandLine)
+{
+    std::cout << "tier   type     gain err dB  thresh err dB    bound dB" << std::endl;
+
+    auto passed = true;
+    passed = checkTier<float> (ViatorCompressor<float>::GainMath::exact, "exact", commandLine) && passed;
+    passed = checkTier<float> (ViatorCompressor<float>::GainMath::fast, "fast", commandLine) && passed;
+    passed = checkTier<double> (ViatorCompressor<double>::GainMath::exact, "exact", commandLine) && passed;
+    passed = checkTier<double> (ViatorCompressor<double>::GainMath::fast, "fast", commandLine) && passed;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << ": gain law error within each tier's stated bound" << std::endl;
+    return passed ? 0 : 1;
+}
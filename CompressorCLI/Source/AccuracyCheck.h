@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    AccuracyCheck.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Runs the SIMD compressor's static gain law against an exact double-precision
+    reference for every threshold from -60 to 0 dB and ratio from 1 to 10, in
+    each GainMath tier and sample type. Returns non-zero if any tier exceeds the
+    error it states in ViatorCompressor::getMaximumErrorDecibels().
+*/
+int runAccuracyCheck (const CommandLine& commandLine);
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    AutomationCheck.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AutomationCheck.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    constexpr float inputLevel = 0.25f;
+
+    int getParameterIndex (CompressorPrototyperAudioProcessor& processor, const juce::String& parameterID)
+    {
+        auto& parameters = processor.getParameters();
+
+        for (auto i = 0; i < parameters.size(); ++i)
+            if (static_cast<juce::RangedAudioParameter*> (parameters[i])->paramID == parameterID)
+                return i;
+
+        return -1;
+    }
+
+    /** The ways processHostBlock() can run a host block: whole, in pieces because it's
+        bigger than prepareToPlay said, or through the fixed-size chunks.
+    */
+    struct HostPath
+    {
+        const char* name;
+        int preparedDivisor, chunkSize;
+    };
+
+    constexpr HostPath hostPaths[] = { { "whole block", 1, 0 }, { "4x prepared size", 4, 0 }, { "64-sample chunks", 1, 64 } };
+
+    /** A processor at unity gain (ratio 1, 0 dB trims) with its ramps settled, so a
+        constant input comes out unchanged until something moves. It has been fed the
+        input level, so whatever its latency hands back from before is that level too.
+    */
+    std::unique_ptr<CompressorPrototyperAudioProcessor> makeSettledProcessor (bool useSimd, int blockSize, const HostPath& path)
+    {
+        auto processor = std::make_unique<CompressorPrototyperAudioProcessor>();
+        processor->setUseSimdCompressor (useSimd);
+        processor->setChunkSize (path.chunkSize);
+        prepareProcessor (*processor, 1, 48000.0, blockSize / path.preparedDivisor);
+
+        juce::AudioBuffer<float> buffer (1, blockSize);
+        juce::MidiBuffer midiMessages;
+
+        for (auto i = 0; i < 48000 / blockSize + 1; ++i)
+        {
+            juce::FloatVectorOperations::fill (buffer.getWritePointer (0), inputLevel, blockSize);
+            processor->processBlock (buffer, midiMessages);
+        }
+
+        return processor;
+    }
+
+    /** Index of the first sample that isn't the input level, or the block size. */
+    int findFirstChange (const juce::AudioBuffer<float>& buffer)
+    {
+        for (auto i = 0; i < buffer.getNumSamples(); ++i)
+            if (buffer.getSample (0, i) != inputLevel)
+                return i;
+
+        return buffer.getNumSamples();
+    }
+
+    /** Moves the output gain to -12 dB at the given offset, the way a host with
+        timestamped automation would, and returns the sample the output first moved on,
+        less the processor's latency. A second block catches a change the latency pushes
+        past the first.
+    */
+    int measureChangeSample (bool useSimd, int blockSize, int offset, const HostPath& path)
+    {
+        auto processor = makeSettledProcessor (useSimd, blockSize, path);
+
+        juce::AudioBuffer<float> buffer (1, 2 * blockSize);
+        juce::MidiBuffer midiMessages;
+        juce::FloatVectorOperations::fill (buffer.getWritePointer (0), inputLevel, 2 * blockSize);
+
+        processor->addParameterEvent (getParameterIndex (*processor, outputGainSliderId), offset, -12.0f);
+        setParameter (*processor, outputGainSliderId, -12.0f);
+
+        for (auto start : { 0, blockSize })
+        {
+            juce::AudioBuffer<float> hostBlock (buffer.getArrayOfWritePointers(), 1, start, blockSize);
+            processor->processBlock (hostBlock, midiMessages);
+        }
+
+        return findFirstChange (buffer) - processor->getLatencySamples();
+    }
+
+    /** Moves the ratio at sample 0 of a noise block, then splits it with events that change
+        nothing more, and compares it with the same move made unsplit.
+    */
+    bool isSplitTransparent (bool useSimd, int blockSize, const HostPath& path)
+    {
+        juce::AudioBuffer<float> plain (1, blockSize), split (1, blockSize);
+        juce::Random random (7);
+        fillWithNoise (plain, random);
+        split.makeCopyOf (plain);
+
+        juce::MidiBuffer midiMessages;
+        auto plainProcessor = makeSettledProcessor (useSimd, blockSize, path);
+        auto splitProcessor = makeSettledProcessor (useSimd, blockSize, path);
+        auto ratioIndex = getParameterIndex (*splitProcessor, ratioSliderId);
+
+        for (auto* processor : { plainProcessor.get(), splitProcessor.get() })
+            setParameter (*processor, ratioSliderId, 4.0f);
+
+        for (auto offset = 0; offset < blockSize; offset += 97)
+            splitProcessor->addParameterEvent (ratioIndex, offset, 4.0f);
+
+        plainProcessor->processBlock (plain, midiMessages);
+        splitProcessor->processBlock (split, midiMessages);
+
+        for (auto i = 0; i < blockSize; ++i)
+            if (plain.getSample (0, i) != split.getSample (0, i))
+                return false;
+
+        return true;
+    }
+}
+
+//==============================================================================
+int runAutomationCheck (const CommandLine& commandLine)
+{
+    const auto blockSize = juce::jmax (2, commandLine.getInt ("block", 1024));
+    auto passed = true;
+
+    for (auto useSimd : { true, false })
+    {
+        for (auto& path : hostPaths)
+        {
+            auto label = juce::String (useSimd ? "simd" : "juce") + ", " + path.name;
+
+            for (auto offset : { 0, 1, 2, blockSize / 3, blockSize / 2 + 1, blockSize - 1 })
+            {
+                auto changeSample = measureChangeSample (useSimd, blockSize, offset, path);
+                auto exact = changeSample == offset;
+                passed = passed && exact;
+
+                std::cout << label << ", event at " << juce::String (offset).paddedLeft (' ', 5) << ": output moves at sample "
+                          << juce::String (changeSample).paddedLeft (' ', 5) << (exact ? "   ok" : "   MISSED") << std::endl;
+            }
+
+            auto transparent = isSplitTransparent (useSimd, blockSize, path);
+            passed = passed && transparent;
+
+            std::cout << label << ", split block with no-op events: " << (transparent ? "bit-identical   ok" : "DIFFERS") << std::endl;
+        }
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << ": automation lands on the sample it was sent for" << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    AutomationCheck.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Sends timestamped output gain changes through addParameterEvent() and checks,
+    for both engines, that each lands on exactly the sample it was sent for, and
+    that events which change nothing leave the output bit-identical to an
+    unsplit block. Both are checked with the host block run whole, in pieces
+    (4x the prepared size) and through 64-sample chunks. Returns non-zero on
+    any miss.
+*/
+int runAutomationCheck (const CommandLine& commandLine);
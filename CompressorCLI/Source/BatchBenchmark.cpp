@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    BatchBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BatchBenchmark.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+
+    struct BatchResult
+    {
+        juce::int64 instanceTicks = 0, planarTicks = 0, interleavedTicks = 0;
+        float planarDifference = 0.0f, interleavedDifference = 0.0f;
+    };
+
+    void configure (CompressorPrototyperAudioProcessor& processor, int channel, bool useFastMath)
+    {
+        setParameter (processor, threshSliderId, -25.0f + (float) (channel % 6) * 5.0f);
+        setParameter (processor, ratioSliderId, 2.0f + (float) (channel % 7));
+        setParameter (processor, attackSliderId, 1.0f + (float) (channel % 11) * 3.0f);
+        setParameter (processor, releaseSliderId, 50.0f + (float) (channel % 3) * 50.0f);
+        setParameter (processor, inputGainSliderId, (float) (channel % 4) - 1.0f);
+        setParameter (processor, outputGainSliderId, (float) (channel % 3));
+        processor.setUseFastGainMath (useFastMath);
+    }
+
+    BatchResult runTier (int numCompressors, int blockSize, double seconds, bool useFastMath, juce::Random& random)
+    {
+        const auto numBlocks = juce::jmax (16, (int) (seconds * sampleRate) / blockSize);
+        const auto gainMath = useFastMath ? BatchCompressor<float>::GainMath::fast : BatchCompressor<float>::GainMath::exact;
+
+        std::vector<std::unique_ptr<CompressorPrototyperAudioProcessor>> processors;
+        std::vector<juce::AudioBuffer<float>> instanceBuffers;
+        BatchCompressor<float> planar, interleaved;
+        juce::MidiBuffer midiMessages;
+
+        planar.setNumCompressors ((size_t) numCompressors);
+        interleaved.setNumCompressors ((size_t) numCompressors);
+
+        for (auto channel = 0; channel < numCompressors; ++channel)
+        {
+            auto& processor = *processors.emplace_back (std::make_unique<CompressorPrototyperAudioProcessor>());
+            configure (processor, channel, useFastMath);
+            prepareProcessor (processor, 1, sampleRate, blockSize);
+            processor.copySettingsTo (planar, (size_t) channel);
+            processor.copySettingsTo (interleaved, (size_t) channel);
+            instanceBuffers.emplace_back (1, blockSize);
+        }
+
+        for (auto* batch : { &planar, &interleaved })
+        {
+            batch->setGainMath (gainMath);
+            batch->prepare (sampleRate, (size_t) blockSize);
+        }
+
+        juce::AudioBuffer<float> input (numCompressors, blockSize), planarBuffer (numCompressors, blockSize);
+        std::vector<float> frames ((size_t) (numCompressors * blockSize));
+        BatchResult result;
+
+        for (auto block = 0; block < numBlocks; ++block)
+        {
+            // Channels at different levels, so each is pushed into its threshold by a different amount
+            fillWithNoise (input, random);
+
+            for (auto channel = 0; channel < numCompressors; ++channel)
+                input.applyGain (channel, 0, blockSize, 0.1f + 0.2f * (float) (channel % 5));
+
+            // Automation lands on a block boundary in all three, and the ramps have to agree
+            if (block == numBlocks / 2)
+            {
+                for (auto channel = 0; channel < numCompressors; channel += 2)
+                {
+                    setParameter (*processors[(size_t) channel], threshSliderId, -20.0f);
+                    processors[(size_t) channel]->copySettingsTo (planar, (size_t) channel);
+                    processors[(size_t) channel]->copySettingsTo (interleaved, (size_t) channel);
+                }
+            }
+
+            planarBuffer.makeCopyOf (input, true);
+
+            for (auto i = 0; i < blockSize; ++i)
+                for (auto channel = 0; channel < numCompressors; ++channel)
+                    frames[(size_t) (i * numCompressors + channel)] = input.getSample (channel, i);
+
+            for (auto channel = 0; channel < numCompressors; ++channel)
+            {
+                auto& buffer = instanceBuffers[(size_t) channel];
+                buffer.copyFrom (0, 0, input, channel, 0, blockSize);
+
+                auto start = juce::Time::getHighResolutionTicks();
+                processors[(size_t) channel]->processBlock (buffer, midiMessages);
+                result.instanceTicks += juce::Time::getHighResolutionTicks() - start;
+            }
+
+            auto start = juce::Time::getHighResolutionTicks();
+            planar.process (planarBuffer.getArrayOfWritePointers(), (size_t) blockSize);
+            result.planarTicks += juce::Time::getHighResolutionTicks() - start;
+
+            start = juce::Time::getHighResolutionTicks();
+            interleaved.processInterleaved (frames.data(), (size_t) blockSize);
+            result.interleavedTicks += juce::Time::getHighResolutionTicks() - start;
+
+            for (auto channel = 0; channel < numCompressors; ++channel)
+            {
+                for (auto i = 0; i < blockSize; ++i)
+                {
+                    auto expected = instanceBuffers[(size_t) channel].getSample (0, i);
+                    result.planarDifference = juce::jmax (result.planarDifference, std::abs (planarBuffer.getSample (channel, i) - expected));
+                    result.interleavedDifference = juce::jmax (result.interleavedDifference,
+                                                               std::abs (frames[(size_t) (i * numCompressors + channel)] - expected));
+                }
+            }
+        }
+
+        return result;
+    }
+}
+
+//==============================================================================
+int runBatchBenchmark (const CommandLine& commandLine)
+{
+    const auto numCompressors = juce::jlimit (1, 4096, commandLine.getInt ("compressors", 32));
+    const auto blockSize = juce::jlimit (16, 8192, commandLine.getInt ("block", 256));
+    const auto seconds = commandLine.getDouble ("seconds", 2.0);
+    juce::Random random (commandLine.getInt ("seed", 1));
+
+    std::cout << numCompressors << " mono compressors at 48 kHz / " << blockSize << ", "
+              << BatchCompressor<float>::numLanes << " per SIMD vector" << std::endl << std::endl
+              << "math     instances ns   planar ns  speedup   interleaved ns  speedup   largest difference" << std::endl;
+
+    auto passed = true;
+
+    for (auto& math : juce::StringArray::fromTokens (commandLine.getOption ("math", "exact,fast"), ",", {}))
+    {
+        auto result = runTier (numCompressors, blockSize, seconds, math == "fast", random);
+
+        // Per sample of one compressor
+        const auto numSamples = (double) numCompressors * blockSize * juce::jmax (16, (int) (seconds * sampleRate) / blockSize);
+        auto nanoseconds = [numSamples] (juce::int64 ticks) { return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e9 / numSamples; };
+        auto difference = juce::Decibels::gainToDecibels (juce::jmax (result.planarDifference, result.interleavedDifference), -200.0f);
+
+        passed = passed && difference <= -100.0f;
+
+        std::cout << math.paddedRight (' ', 6)
+                  << juce::String (nanoseconds (result.instanceTicks), 2).paddedLeft (' ', 15)
+                  << juce::String (nanoseconds (result.planarTicks), 2).paddedLeft (' ', 12)
+                  << (juce::String ((double) result.instanceTicks / (double) result.planarTicks, 2) + "x").paddedLeft (' ', 9)
+                  << juce::String (nanoseconds (result.interleavedTicks), 2).paddedLeft (' ', 17)
+                  << (juce::String ((double) result.instanceTicks / (double) result.interleavedTicks, 2) + "x").paddedLeft (' ', 9)
+                  << (juce::String (difference, 1) + " dBFS").paddedLeft (' ', 21) << std::endl;
+    }
+
+    std::cout << std::endl << (passed ? "PASSED" : "FAILED") << ": the batch matches the separate instances" << std::endl;
+    return passed ? 0 : 1;
+}
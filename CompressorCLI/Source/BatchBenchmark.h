@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    BatchBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** --compressors=32 mono channels with varied settings at 48 kHz / --block=256.
+    They run as separate processor instances, as one BatchCompressor over planar
+    buffers and as one over interleaved frames, for each tier in --math=exact,fast.
+    Halfway through, every other channel's threshold moves. Prints the time per
+    sample for each and the largest difference from the instances. Returns
+    non-zero if the batch strays above -100 dBFS.
+*/
+int runBatchBenchmark (const CommandLine& commandLine);
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    BatchRender.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BatchRender.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    struct RenderResult
+    {
+        double audioSeconds = 0.0;
+        double renderSeconds = 0.0;
+        double dspSeconds = 0.0;
+        juce::String error;
+    };
+
+    //==============================================================================
+    class RenderWorker  : public juce::ThreadPoolJob
+    {
+    public:
+        RenderWorker (CompressorPrototyperAudioProcessor& p, const juce::Array<juce::File>& filesToRender,
+                      std::vector<RenderResult>& resultsToFill, std::atomic<int>& sharedCounter,
+                      const juce::File& destination, int samplesPerBlock)
+            : juce::ThreadPoolJob ("RenderWorker"), processor (p), files (filesToRender), results (resultsToFill),
+              nextFile (sharedCounter), outputDir (destination), blockSize (samplesPerBlock)
+        {
+            formatManager.registerBasicFormats();
+        }
+
+        JobStatus runJob() override
+        {
+            for (;;)
+            {
+                auto index = nextFile.fetch_add (1);
+
+                if (index >= files.size() || shouldExit())
+                    break;
+
+                results[(size_t) index] = renderFile (files.getReference (index));
+            }
+
+            return jobHasFinished;
+        }
+
+    private:
+        RenderResult renderFile (const juce::File& input)
+        {
+            RenderResult result;
+            auto renderStart = juce::Time::getHighResolutionTicks();
+
+            std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (input));
+
+            if (reader == nullptr)
+            {
+                result.error = "unreadable file";
+                return result;
+            }
+
+            auto numChannels = (int) reader->numChannels;
+            auto sampleRate = reader->sampleRate;
+
+            if (! prepareProcessor (processor, numChannels, sampleRate, blockSize))
+            {
+                result.error = "unsupported channel count (" + juce::String (numChannels) + ")";
+                return result;
+            }
+
+            auto outputFile = outputDir.getChildFile (input.getFileNameWithoutExtension() + "_compressed.wav");
+            outputFile.deleteFile();
+
+            auto stream = std::make_unique<juce::FileOutputStream> (outputFile);
+            juce::WavAudioFormat wavFormat;
+            std::unique_ptr<juce::AudioFormatWriter> writer;
+
+            if (! stream->failedToOpen())
+                writer.reset (wavFormat.createWriterFor (stream.get(), sampleRate, (unsigned int) numChannels,
+                                                         (int) juce::jmax (16u, reader->bitsPerSample), {}, 0));
+
+            if (writer == nullptr)
+            {
+                result.error = "couldn't create " + outputFile.getFullPathName();
+                return result;
+            }
+
+            stream.release(); // now owned by the writer
+
+            juce::AudioBuffer<float> buffer (numChannels, blockSize);
+            juce::MidiBuffer midiMessages;
+            juce::int64 dspTicks = 0;
+
+            for (juce::int64 position = 0; position < reader->lengthInSamples; position += blockSize)
+            {
+                auto numSamples = (int) juce::jmin ((juce::int64) blockSize, reader->lengthInSamples - position);
+                buffer.setSize (numChannels, numSamples, false, false, true);
+                reader->read (&buffer, 0, numSamples, position, true, true);
+
+                auto blockStart = juce::Time::getHighResolutionTicks();
+                processor.processBlock (buffer, midiMessages);
+                dspTicks += juce::Time::getHighResolutionTicks() - blockStart;
+
+                writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+            }
+
+            processor.releaseResources();
+            writer.reset();
+
+            result.audioSeconds = (double) reader->lengthInSamples / sampleRate;
+            result.dspSeconds = juce::Time::highResolutionTicksToSeconds (dspTicks);
+            result.renderSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - renderStart);
+            return result;
+        }
+
+        CompressorPrototyperAudioProcessor& processor;
+        const juce::Array<juce::File>& files;
+        std::vector<RenderResult>& results;
+        std::atomic<int>& nextFile;
+        juce::File outputDir;
+        int blockSize;
+        juce::AudioFormatManager formatManager;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderWorker)
+    };
+
+    juce::String realtimeFactor (double audioSeconds, double seconds)
+    {
+        return juce::String (seconds > 0.0 ? audioSeconds / seconds : 0.0, 1) + "x";
+    }
+}
+
+//==============================================================================
+int runBatchRender (const CommandLine& commandLine)
+{
+    auto workingDir = juce::File::getCurrentWorkingDirectory();
+    juce::Array<juce::File> files;
+
+    for (auto& path : commandLine.positional)
+        files.add (workingDir.getChildFile (path));
+
+    if (commandLine.hasOption ("list"))
+    {
+        juce::StringArray lines;
+        lines.addLines (workingDir.getChildFile (commandLine.getOption ("list")).loadFileAsString());
+        lines.trim();
+        lines.removeEmptyStrings();
+
+        for (auto& path : lines)
+            files.add (workingDir.getChildFile (path));
+    }
+
+    if (files.isEmpty())
+    {
+        std::cerr << "Usage: CompressorCLI render [--list=files.txt] [--out=dir] [--threads=N] [--block=512] [files...]" << std::endl
+                  << parameterOptionsHelp() << std::endl;
+        return 1;
+    }
+
+    auto outputDir = workingDir.getChildFile (commandLine.getOption ("out", "rendered"));
+    outputDir.createDirectory();
+
+    auto blockSize = juce::jmax (1, commandLine.getInt ("block", 512));
+    auto numWorkers = juce::jlimit (1, files.size(), commandLine.getInt ("threads", juce::SystemStats::getNumCpus()));
+
+    // Processors are built and configured here on the message thread; each worker
+    // then has exclusive use of its own instance.
+    std::vector<std::unique_ptr<CompressorPrototyperAudioProcessor>> processors;
+
+    for (auto i = 0; i < numWorkers; ++i)
+    {
+        processors.push_back (std::make_unique<CompressorPrototyperAudioProcessor>());
+        applyParameterOptions (*processors.back(), commandLine);
+    }
+
+    std::vector<RenderResult> results ((size_t) files.size());
+    std::atomic<int> nextFile { 0 };
+    juce::OwnedArray<RenderWorker> workers;
+
+    auto start = juce::Time::getHighResolutionTicks();
+
+    {
+        juce::ThreadPool pool (numWorkers);
+
+        for (auto& processor : processors)
+        {
+            workers.add (new RenderWorker (*processor, files, results, nextFile, outputDir, blockSize));
+            pool.addJob (workers.getLast(), false);
+        }
+
+        for (auto* worker : workers)
+            pool.waitForJobToFinish (worker, -1);
+    }
+
+    auto wallSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+    auto totalAudioSeconds = 0.0, totalDspSeconds = 0.0;
+    auto numFailed = 0;
+
+    for (auto i = 0; i < files.size(); ++i)
+    {
+        auto& result = results[(size_t) i];
+        std::cout << files[i].getFileName() << ": ";
+
+        if (result.error.isNotEmpty())
+        {
+            std::cout << "FAILED - " << result.error << std::endl;
+            ++numFailed;
+            continue;
+        }
+
+        totalAudioSeconds += result.audioSeconds;
+        totalDspSeconds += result.dspSeconds;
+
+        std::cout << juce::String (result.audioSeconds, 2) << "s audio, "
+                  << realtimeFactor (result.audioSeconds, result.renderSeconds) << " realtime (dsp only "
+                  << realtimeFactor (result.audioSeconds, result.dspSeconds) << ")" << std::endl;
+    }
+
+    std::cout << "Total: " << files.size() - numFailed << " files, " << juce::String (totalAudioSeconds, 2) << "s audio in "
+              << juce::String (wallSeconds, 2) << "s on " << numWorkers << " threads, "
+              << realtimeFactor (totalAudioSeconds, wallSeconds) << " realtime (dsp per core "
+              << realtimeFactor (totalAudioSeconds, totalDspSeconds) << ")" << std::endl;
+
+    return numFailed > 0 ? 1 : 0;
+}
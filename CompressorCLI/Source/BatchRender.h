@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    BatchRender.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Renders a list of audio files through CompressorPrototyperAudioProcessor
+    without an editor or host.
+
+    Each worker on the thread pool owns one processor instance and pulls the next
+    file index from a shared counter, so throughput scales with the number of
+    cores while the pool itself stays bounded.
+*/
+int runBatchRender (const CommandLine& commandLine);
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    ChunkBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ChunkBenchmark.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    struct Run
+    {
+        double nanosecondsPerSample = 0.0;
+        juce::AudioBuffer<float> output;
+    };
+
+    /** A move of one parameter at a sample of the input, as host automation sends it. */
+    struct AutomationPoint
+    {
+        juce::String parameterID;
+        int position;
+        float value;
+    };
+
+    /** A few moves at odd positions, so they land inside host blocks and chunks of every size
+        and a split block has to hold them back until their own piece.
+    */
+    std::vector<AutomationPoint> makeAutomation (int numSamples)
+    {
+        return { { threshSliderId,     numSamples / 8 + 3,     -10.0f },
+                 { ratioSliderId,      numSamples / 3 + 17,      8.0f },
+                 { outputGainSliderId, numSamples / 2 + 101,    -6.0f },
+                 { threshSliderId,     numSamples / 2 + 1001,  -25.0f },
+                 { ratioSliderId,      3 * numSamples / 4 + 1,   2.0f } };
+    }
+
+    /** Processes the whole input through a fresh processor, hostBlockSize samples per call,
+        delivering the automation timestamped within the block it falls in. As a host does,
+        each parameter is also set to its last value in the block before the call.
+    */
+    Run processInHostBlocks (const juce::AudioBuffer<float>& input, const std::vector<AutomationPoint>& automation,
+                             int chunkSize, int preparedBlockSize, int hostBlockSize, bool useSimd)
+    {
+        CompressorPrototyperAudioProcessor processor;
+        processor.setUseSimdCompressor (useSimd);
+        processor.setChunkSize (chunkSize);
+        prepareProcessor (processor, input.getNumChannels(), 48000.0, preparedBlockSize);
+
+        // Enough gain reduction that the envelopes are busy
+        setParameter (processor, ratioSliderId, 4.0f);
+        setParameter (processor, threshSliderId, -20.0f);
+
+        Run run;
+        run.output.makeCopyOf (input);
+
+        juce::AudioBuffer<float> hostBuffer (input.getNumChannels(), hostBlockSize);
+        juce::MidiBuffer midiMessages;
+        juce::int64 totalTicks = 0;
+
+        for (auto start = 0; start < input.getNumSamples(); start += hostBlockSize)
+        {
+            auto length = juce::jmin (hostBlockSize, input.getNumSamples() - start);
+            hostBuffer.setSize (input.getNumChannels(), length, false, false, true);
+
+            for (auto channel = 0; channel < input.getNumChannels(); ++channel)
+                hostBuffer.copyFrom (channel, 0, run.output, channel, start, length);
+
+            for (auto& point : automation)
+            {
+                if (point.position >= start && point.position < start + length)
+                {
+                    auto* param = processor.treeState.getParameter (point.parameterID);
+                    processor.addParameterEvent (param->getParameterIndex(), point.position - start, point.value);
+                    setParameter (processor, point.parameterID, point.value);
+                }
+            }
+
+            auto startTicks = juce::Time::getHighResolutionTicks();
+            processor.processBlock (hostBuffer, midiMessages);
+            totalTicks += juce::Time::getHighResolutionTicks() - startTicks;
+
+            for (auto channel = 0; channel < input.getNumChannels(); ++channel)
+                run.output.copyFrom (channel, start, hostBuffer, channel, 0, length);
+        }
+
+        processor.releaseResources();
+
+        run.nanosecondsPerSample = juce::Time::highResolutionTicksToSeconds (totalTicks) * 1.0e9 / (double) input.getNumSamples();
+        return run;
+    }
+
+    bool isIdentical (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        for (auto channel = 0; channel < a.getNumChannels(); ++channel)
+            if (std::memcmp (a.getReadPointer (channel), b.getReadPointer (channel), sizeof (float) * (size_t) a.getNumSamples()) != 0)
+                return false;
+
+        return true;
+    }
+}
+
+//==============================================================================
+int runChunkBenchmark (const CommandLine& commandLine)
+{
+    const auto seconds = commandLine.getDouble ("seconds", 2.0);
+    const auto preparedBlockSize = juce::jmax (1, commandLine.getInt ("prepared", 512));
+    const auto useSimd = commandLine.getOption ("engine", "simd") != "juce";
+
+    juce::Array<int> chunkSizes;
+
+    for (auto& token : juce::StringArray::fromTokens (commandLine.getOption ("chunks", "0,64"), ",", {}))
+        chunkSizes.add (juce::jmax (0, token.getIntValue()));
+
+    juce::AudioBuffer<float> input (2, (int) (seconds * 48000.0));
+    juce::Random random (commandLine.getInt ("seed", 1));
+    fillWithNoise (input, random);
+
+    const auto automation = makeAutomation (input.getNumSamples());
+    auto passed = true;
+
+    for (auto chunkSize : chunkSizes)
+    {
+        std::cout << "chunk " << (chunkSize == 0 ? juce::String ("off") : juce::String (chunkSize))
+                  << ", prepared for " << preparedBlockSize << " (" << (useSimd ? "simd" : "juce") << ")" << std::endl
+                  << "  host block   ns/sample   output vs " << preparedBlockSize << "-sample blocks" << std::endl;
+
+        auto reference = processInHostBlocks (input, automation, chunkSize, preparedBlockSize, preparedBlockSize, useSimd);
+
+        for (auto hostBlockSize = 1; hostBlockSize <= 8192; hostBlockSize *= 2)
+        {
+            auto run = processInHostBlocks (input, automation, chunkSize, preparedBlockSize, hostBlockSize, useSimd);
+            auto identical = isIdentical (run.output, reference.output);
+            passed = passed && identical;
+
+            std::cout << juce::String (hostBlockSize).paddedLeft (' ', 12)
+                      << juce::String (run.nanosecondsPerSample, 2).paddedLeft (' ', 12) << "   "
+                      << (identical ? "identical" : "DIFFERS") << std::endl;
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << ": output, automation included, independent of the host block size" << std::endl;
+    return passed ? 0 : 1;
+}
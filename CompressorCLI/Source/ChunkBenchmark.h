@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    ChunkBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Feeds the same noise and timestamped automation through processBlock in host
+    blocks of 1 to 8192 samples, with the processor prepared for 512, for each
+    internal chunk size (--chunks=0,64; 0 is off). Prints ns/sample per host block
+    size and whether the output matches the 512-sample run bit for bit, which
+    covers automation inside blocks split for size and inside chunks. Returns
+    non-zero if any run differs.
+*/
+int runChunkBenchmark (const CommandLine& commandLine);
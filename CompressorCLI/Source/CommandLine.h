@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    CommandLine.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../CompressorPrototyper/Source/PluginProcessor.h"
+
+//==============================================================================
+/** Splits the arguments after the command name into "--name=value" options and
+    positional arguments (usually file paths).
+*/
+struct CommandLine
+{
+    CommandLine (const juce::StringArray& args)
+    {
+        for (auto& arg : args)
+        {
+            if (arg.startsWith ("--"))
+                options.set (arg.substring (2).upToFirstOccurrenceOf ("=", false, false),
+                             arg.fromFirstOccurrenceOf ("=", false, false));
+            else
+                positional.add (arg);
+        }
+    }
+
+    bool hasOption (const juce::String& name) const                  { return options.containsKey (name); }
+    juce::String getOption (const juce::String& name, const juce::String& fallback = {}) const
+    {
+        return hasOption (name) ? options[name] : fallback;
+    }
+
+    int getInt (const juce::String& name, int fallback) const         { return hasOption (name) ? options[name].getIntValue() : fallback; }
+    double getDouble (const juce::String& name, double fallback) const { return hasOption (name) ? options[name].getDoubleValue() : fallback; }
+
+    juce::StringPairArray options;
+    juce::StringArray positional;
+};
+
+//==============================================================================
+/** Copies any of the six treeState parameters given on the command line
+    (e.g. --ratio=4 --thresh=-12) into the processor, in real-world units.
+*/
+inline void applyParameterOptions (CompressorPrototyperAudioProcessor& processor, const CommandLine& commandLine)
+{
+    for (auto* id : { inputGainSliderId, ratioSliderId, threshSliderId, attackSliderId, releaseSliderId, outputGainSliderId })
+    {
+        if (! commandLine.hasOption (id))
+            continue;
+
+        if (auto* param = processor.treeState.getParameter (id))
+            param->setValueNotifyingHost (param->convertTo0to1 ((float) commandLine.getDouble (id, 0.0)));
+    }
+}
+
+inline juce::String parameterOptionsHelp()
+{
+    return "  --" inputGainSliderId "=dB  --" ratioSliderId "=1..10  --" threshSliderId "=-30..0  --" attackSliderId "=ms  --"
+           releaseSliderId "=ms  --" outputGainSliderId "=dB";
+}
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    EngineBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "EngineBenchmark.h"
+
+namespace
+{
+    template <typename Compressor>
+    double nanosecondsPerSample (Compressor& compressor, juce::AudioBuffer<float>& buffer, int numBlocks)
+    {
+        compressor.setThreshold (-24.0f);
+        compressor.setRatio (4.0f);
+        compressor.setAttack (5.0f);
+        compressor.setRelease (100.0f);
+
+        juce::dsp::AudioBlock<float> block (buffer);
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (auto i = 0; i < numBlocks; ++i)
+            compressor.process (juce::dsp::ProcessContextReplacing<float> (block));
+
+        auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / ((double) numBlocks * buffer.getNumSamples() * buffer.getNumChannels());
+    }
+}
+
+//==============================================================================
+int runEngineBenchmark (const CommandLine& commandLine)
+{
+    const auto sampleRate = commandLine.getDouble ("rate", 48000.0);
+    const auto seconds = commandLine.getDouble ("seconds", 10.0);
+
+    std::cout << "SIMD lanes: " << ViatorCompressor<float>::numLanes << std::endl
+              << "channels  block   juce ns/sample   simd ns/sample   speedup   fast ns/sample   speedup    rms ns/sample   vs peak" << std::endl;
+
+    juce::Random random;
+
+    for (auto numChannels : { 1, 2, 4, 8 })
+    {
+        for (auto blockSize : { 32, 128, 512 })
+        {
+            juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels };
+            juce::AudioBuffer<float> buffer (numChannels, blockSize);
+            auto numBlocks = juce::jmax (1, (int) (seconds * sampleRate) / blockSize);
+
+            auto refill = [&]
+            {
+                for (auto channel = 0; channel < numChannels; ++channel)
+                    for (auto i = 0; i < blockSize; ++i)
+                        buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+            };
+
+            juce::dsp::Compressor<float> juceCompressor;
+            juceCompressor.prepare (spec);
+            refill();
+            auto juceTime = nanosecondsPerSample (juceCompressor, buffer, numBlocks);
+
+            ViatorCompressor<float> simdCompressor;
+            simdCompressor.prepare (spec);
+            refill();
+            auto simdTime = nanosecondsPerSample (simdCompressor, buffer, numBlocks);
+
+            ViatorCompressor<float> fastCompressor;
+            fastCompressor.prepare (spec);
+            fastCompressor.setGainMath (ViatorCompressor<float>::GainMath::fast);
+            refill();
+            auto fastTime = nanosecondsPerSample (fastCompressor, buffer, numBlocks);
+
+            ViatorCompressor<float> rmsCompressor;
+            rmsCompressor.prepare (spec);
+            rmsCompressor.setLevelDetection (ViatorCompressor<float>::LevelDetection::rms);
+            refill();
+            auto rmsTime = nanosecondsPerSample (rmsCompressor, buffer, numBlocks);
+
+            std::cout << juce::String (numChannels).paddedLeft (' ', 8) << juce::String (blockSize).paddedLeft (' ', 7)
+                      << juce::String (juceTime, 3).paddedLeft (' ', 17) << juce::String (simdTime, 3).paddedLeft (' ', 17)
+                      << juce::String (juceTime / simdTime, 2).paddedLeft (' ', 9) << "x"
+                      << juce::String (fastTime, 3).paddedLeft (' ', 16) << juce::String (juceTime / fastTime, 2).paddedLeft (' ', 9) << "x"
+                      << juce::String (rmsTime, 3).paddedLeft (' ', 17) << juce::String (rmsTime / simdTime, 2).paddedLeft (' ', 9) << "x" << std::endl;
+        }
+    }
+
+    // The running sum should make the RMS cost flat across window lengths
+    std::cout << std::endl << "rms window ms   ns/sample (2 channels, 512 samples)" << std::endl;
+
+    for (auto windowMs : { 1.0f, 10.0f, 50.0f, 100.0f, 300.0f })
+    {
+        juce::AudioBuffer<float> buffer (2, 512);
+
+        for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (auto i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        ViatorCompressor<float> rmsCompressor;
+        rmsCompressor.prepare ({ sampleRate, 512, 2 });
+        rmsCompressor.setLevelDetection (ViatorCompressor<float>::LevelDetection::rms);
+        rmsCompressor.setRmsWindow (windowMs);
+
+        auto time = nanosecondsPerSample (rmsCompressor, buffer, juce::jmax (1, (int) (seconds * sampleRate) / 512));
+        std::cout << juce::String (windowMs, 0).paddedLeft (' ', 13) << juce::String (time, 3).paddedLeft (' ', 12) << std::endl;
+    }
+
+    return 0;
+}
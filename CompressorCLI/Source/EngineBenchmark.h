@@ -0,0 +1,18 @@
+/*
+  ==============================================================================
+
+    EngineBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Times ViatorCompressor against juce::dsp::Compressor on the same noise input
+    and prints ns/sample for both, per channel count and block size.
+*/
+int runEngineBenchmark (const CommandLine& commandLine);
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    HibernateBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "HibernateBenchmark.h"
+#include "MemoryUsage.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    void configure (CompressorPrototyperAudioProcessor& processor, int oversamplingStages, int numBands)
+    {
+        setParameter (processor, ratioSliderId, 4.0f);
+        setParameter (processor, threshSliderId, -20.0f);
+        setParameter (processor, oversamplingSliderId, (float) oversamplingStages);
+        setParameter (processor, bandsSliderId, (float) numBands);
+        prepareProcessor (processor, 2, sampleRate, blockSize);
+    }
+
+    /** Noise, then enough silence for the tail to die away, as a track does before a host suspends it. */
+    void playThenStop (CompressorPrototyperAudioProcessor& processor, juce::Random& random)
+    {
+        juce::AudioBuffer<float> buffer (2, blockSize);
+        juce::MidiBuffer midiMessages;
+        const auto numSilentBlocks = (int) std::ceil ((processor.getTailLengthSeconds() + 0.1) * sampleRate / blockSize);
+
+        for (auto block = 0; block < (int) (sampleRate / blockSize); ++block)
+        {
+            fillWithNoise (buffer, random);
+            processor.processBlock (buffer, midiMessages);
+        }
+
+        for (auto block = 0; block < numSilentBlocks; ++block)
+        {
+            buffer.clear();
+            processor.processBlock (buffer, midiMessages);
+        }
+    }
+
+    void printMemory (const juce::String& label, size_t residentBytes, size_t heapBytes)
+    {
+        std::cout << "  " << label.paddedRight (' ', 26)
+                  << formatBytes ((double) residentBytes).paddedLeft (' ', 12)
+                  << formatBytes ((double) heapBytes).paddedLeft (' ', 14) << std::endl;
+    }
+}
+
+//==============================================================================
+int runHibernateBenchmark (const CommandLine& commandLine)
+{
+    const auto numInstances = juce::jmax (1, commandLine.getInt ("instances", 500));
+    const auto oversamplingStages = juce::jlimit (0, 3, commandLine.getInt ("oversampling", 0));
+    const auto numBands = juce::jlimit (1, MultibandCompressor<float>::maximumBands, commandLine.getInt ("bands", 1));
+    juce::Random random (commandLine.getInt ("seed", 1));
+
+    std::vector<std::unique_ptr<CompressorPrototyperAudioProcessor>> processors;
+
+    releaseFreeHeap();
+    auto residentAtStart = getResidentBytes();
+    auto heapAtStart = getHeapBytes();
+
+    for (auto i = 0; i < numInstances; ++i)
+    {
+        processors.push_back (std::make_unique<CompressorPrototyperAudioProcessor>());
+        configure (*processors.back(), oversamplingStages, numBands);
+        playThenStop (*processors.back(), random);
+    }
+
+    releaseFreeHeap();
+    auto residentPlaying = getResidentBytes();
+    auto heapPlaying = getHeapBytes();
+
+    auto start = juce::Time::getMillisecondCounterHiRes();
+
+    for (auto& processor : processors)
+        processor->releaseResources();
+
+    auto releaseTime = juce::Time::getMillisecondCounterHiRes() - start;
+
+    releaseFreeHeap();
+    auto residentHibernating = getResidentBytes();
+    auto heapHibernating = getHeapBytes();
+
+    start = juce::Time::getMillisecondCounterHiRes();
+
+    for (auto& processor : processors)
+        processor->prepareToPlay (sampleRate, blockSize);
+
+    auto prepareTime = juce::Time::getMillisecondCounterHiRes() - start;
+
+    std::cout << numInstances << " stereo instances at 48 kHz / " << blockSize << ", oversampling "
+              << (1 << oversamplingStages) << "x, " << numBands << (numBands == 1 ? " band" : " bands") << std::endl << std::endl
+              << "  " << juce::String().paddedRight (' ', 26) << "    resident          heap" << std::endl;
+
+    printMemory ("no instances", residentAtStart, heapAtStart);
+    printMemory ("prepared, after playing", residentPlaying, heapPlaying);
+    printMemory ("hibernating", residentHibernating, heapHibernating);
+
+    std::cout << std::endl << "  freed per instance: " << formatBytes (((double) heapPlaying - (double) heapHibernating) / numInstances)
+              << " heap, " << formatBytes (((double) residentPlaying - (double) residentHibernating) / numInstances) << " resident" << std::endl
+              << "  releaseResources " << juce::String (releaseTime * 1000.0 / numInstances, 1) << " us, prepareToPlay again "
+              << juce::String (prepareTime * 1000.0 / numInstances, 1) << " us per instance" << std::endl;
+
+    // Resume one instance and compare its first block with one that stayed prepared through the silence
+    CompressorPrototyperAudioProcessor awake, hibernated;
+    juce::Random awakeRandom (7), hibernatedRandom (7);
+
+    configure (awake, oversamplingStages, numBands);
+    configure (hibernated, oversamplingStages, numBands);
+    playThenStop (awake, awakeRandom);
+    playThenStop (hibernated, hibernatedRandom);
+
+    hibernated.releaseResources();
+    hibernated.prepareToPlay (sampleRate, blockSize);
+
+    juce::AudioBuffer<float> awakeBlock (2, blockSize), resumedBlock (2, blockSize);
+    juce::MidiBuffer midiMessages;
+    fillWithNoise (awakeBlock, awakeRandom);
+    resumedBlock.makeCopyOf (awakeBlock);
+    awake.processBlock (awakeBlock, midiMessages);
+    hibernated.processBlock (resumedBlock, midiMessages);
+
+    auto difference = 0.0f;
+
+    for (auto channel = 0; channel < 2; ++channel)
+        for (auto i = 0; i < blockSize; ++i)
+            difference = juce::jmax (difference, std::abs (awakeBlock.getSample (channel, i) - resumedBlock.getSample (channel, i)));
+
+    auto differenceDecibels = juce::Decibels::gainToDecibels (difference, -200.0f);
+    auto passed = differenceDecibels <= -80.0f;
+
+    std::cout << std::endl << (passed ? "PASSED" : "FAILED") << ": first block after resuming is within "
+              << juce::String (differenceDecibels, 1) << " dBFS of an instance that never hibernated" << std::endl;
+    return passed ? 0 : 1;
+}
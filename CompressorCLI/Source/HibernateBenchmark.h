@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    HibernateBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Prepares --instances=500 stereo processors at 48 kHz (with --oversampling=0-3
+    stages and --bands=N), plays a second of noise through each and then silence
+    past the tail. Then calls releaseResources() on all of them, as a host does
+    when it suspends them. Prints resident and heap memory before and after, and
+    the cost of preparing them all again. Then checks that the first block after
+    resuming matches an instance that never hibernated; returns non-zero if it
+    differs by more than -80 dB.
+*/
+int runHibernateBenchmark (const CommandLine& commandLine);
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    IdleBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "IdleBenchmark.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    enum TrackType { compressing, unity, idle, numTrackTypes };
+
+    const char* const trackTypeNames[] = { "compressing", "ratio 1, 0 dB", "silent" };
+
+    struct Session
+    {
+        std::array<double, numTrackTypes> seconds {};
+        double tailSeconds = 0.0;
+        juce::AudioBuffer<float> mix;
+    };
+
+    /** Plays the whole session one block at a time, every track in turn, as a host's
+        audio thread would, and sums the tracks into a mix for comparing runs.
+    */
+    Session runSession (const juce::Array<TrackType>& tracks, const juce::AudioBuffer<float>& source,
+                        int blockSize, int clipSamples, bool useFastPaths, bool useSimd)
+    {
+        const auto sampleRate = 48000.0;
+        juce::OwnedArray<CompressorPrototyperAudioProcessor> processors;
+
+        for (auto type : tracks)
+        {
+            auto* processor = processors.add (new CompressorPrototyperAudioProcessor());
+            processor->setUseSimdCompressor (useSimd);
+            processor->setUseFastPaths (useFastPaths);
+            prepareProcessor (*processor, 2, sampleRate, blockSize);
+
+            if (type != unity)
+            {
+                setParameter (*processor, ratioSliderId, 4.0f);
+                setParameter (*processor, threshSliderId, -20.0f);
+            }
+        }
+
+        Session session;
+        session.tailSeconds = processors.getFirst()->getTailLengthSeconds();
+        session.mix.setSize (2, source.getNumSamples());
+        session.mix.clear();
+
+        juce::AudioBuffer<float> buffer (2, blockSize);
+        juce::MidiBuffer midiMessages;
+        std::array<juce::int64, numTrackTypes> ticks {};
+
+        for (auto start = 0; start + blockSize <= source.getNumSamples(); start += blockSize)
+        {
+            for (auto track = 0; track < tracks.size(); ++track)
+            {
+                // Each track reads the source from its own offset so they don't all peak together
+                auto offset = (start + track * 997) % (source.getNumSamples() - blockSize);
+                auto isPlaying = tracks[track] != idle || start + blockSize <= clipSamples;
+
+                for (auto channel = 0; channel < 2; ++channel)
+                {
+                    if (isPlaying)
+                        buffer.copyFrom (channel, 0, source, channel, offset, blockSize);
+                    else
+                        buffer.clear (channel, 0, blockSize);
+                }
+
+                auto startTicks = juce::Time::getHighResolutionTicks();
+                processors.getUnchecked (track)->processBlock (buffer, midiMessages);
+                ticks[(size_t) tracks[track]] += juce::Time::getHighResolutionTicks() - startTicks;
+
+                for (auto channel = 0; channel < 2; ++channel)
+                    session.mix.addFrom (channel, start, buffer, channel, 0, blockSize);
+            }
+        }
+
+        for (size_t type = 0; type < ticks.size(); ++type)
+            session.seconds[type] = juce::Time::highResolutionTicksToSeconds (ticks[type]);
+
+        return session;
+    }
+
+    /** Plays a clip, then silence far past the tail with the threshold and both gains moved
+        in its last block, then the first block of signal coming back, and returns that block.
+    */
+    juce::AudioBuffer<float> playChangeDuringSilence (const juce::AudioBuffer<float>& source, int blockSize,
+                                                      bool useFastPaths, bool useSimd)
+    {
+        CompressorPrototyperAudioProcessor processor;
+        processor.setUseSimdCompressor (useSimd);
+        processor.setUseFastPaths (useFastPaths);
+        prepareProcessor (processor, 2, 48000.0, blockSize);
+        setParameter (processor, ratioSliderId, 4.0f);
+        setParameter (processor, threshSliderId, -20.0f);
+
+        // Half a second of signal, then a second of silence
+        const auto numSignalBlocks = 24000 / blockSize + 1;
+        const auto numBlocks = numSignalBlocks + 48000 / blockSize + 1;
+
+        juce::AudioBuffer<float> buffer (2, blockSize);
+        juce::MidiBuffer midiMessages;
+
+        for (auto block = 0; block <= numBlocks; ++block)
+        {
+            auto isPlaying = block < numSignalBlocks || block == numBlocks;
+            auto offset = (block * blockSize) % (source.getNumSamples() - blockSize);
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                if (isPlaying)
+                    buffer.copyFrom (channel, 0, source, channel, offset, blockSize);
+                else
+                    buffer.clear (channel, 0, blockSize);
+            }
+
+            if (block == numBlocks - 1)
+            {
+                setParameter (processor, threshSliderId, -30.0f);
+                setParameter (processor, inputGainSliderId, 6.0f);
+                setParameter (processor, outputGainSliderId, -6.0f);
+            }
+
+            processor.processBlock (buffer, midiMessages);
+        }
+
+        return buffer;
+    }
+
+    double total (const Session& session)
+    {
+        return std::accumulate (session.seconds.begin(), session.seconds.end(), 0.0);
+    }
+}
+
+//==============================================================================
+int runIdleBenchmark (const CommandLine& commandLine)
+{
+    const auto numTracks = juce::jmax (1, commandLine.getInt ("tracks", 200));
+    const auto activePercent = juce::jlimit (0, 100, commandLine.getInt ("active", 10));
+    const auto unityPercent = juce::jlimit (0, 100 - activePercent, commandLine.getInt ("unity", 20));
+    const auto seconds = juce::jmax (1.0, commandLine.getDouble ("seconds", 10.0));
+    const auto blockSize = juce::jmax (16, commandLine.getInt ("block", 256));
+    const auto useSimd = commandLine.getOption ("engine", "simd") != "juce";
+
+    // The silent tracks' clips end half a second in
+    const auto clipSamples = 24000;
+
+    juce::AudioBuffer<float> source (2, (int) (seconds * 48000.0));
+    juce::Random random (commandLine.getInt ("seed", 1));
+    fillWithNoise (source, random);
+
+    juce::Array<TrackType> tracks;
+    std::array<int, numTrackTypes> numOfType {};
+
+    for (auto track = 0; track < numTracks; ++track)
+    {
+        auto percentile = track * 100 / numTracks;
+        auto type = percentile < activePercent ? compressing : (percentile < activePercent + unityPercent ? unity : idle);
+        tracks.add (type);
+        ++numOfType[(size_t) type];
+    }
+
+    std::cout << numTracks << " stereo tracks, " << seconds << " s at 48 kHz in " << blockSize << "-sample blocks ("
+              << (useSimd ? "simd" : "juce") << ")" << std::endl;
+
+    auto slow = runSession (tracks, source, blockSize, clipSamples, false, useSimd);
+    auto fast = runSession (tracks, source, blockSize, clipSamples, true, useSimd);
+
+    std::cout << "reported tail " << juce::String (fast.tailSeconds * 1000.0, 1) << " ms" << std::endl << std::endl
+              << "  tracks              fast paths off   fast paths on    saved" << std::endl;
+
+    auto printRow = [] (const juce::String& name, int count, double slowSeconds, double fastSeconds)
+    {
+        auto saved = slowSeconds > 0.0 ? 100.0 * (1.0 - fastSeconds / slowSeconds) : 0.0;
+
+        std::cout << "  " << (juce::String (count) + " " + name).paddedRight (' ', 18)
+                  << (juce::String (slowSeconds * 1000.0, 1) + " ms").paddedLeft (' ', 16)
+                  << (juce::String (fastSeconds * 1000.0, 1) + " ms").paddedLeft (' ', 16)
+                  << (juce::String (saved, 1) + "%").paddedLeft (' ', 9) << std::endl;
+    };
+
+    for (size_t type = 0; type < (size_t) numTrackTypes; ++type)
+        printRow (trackTypeNames[type], numOfType[type], slow.seconds[type], fast.seconds[type]);
+
+    printRow ("in session", numTracks, total (slow), total (fast));
+
+    std::cout << std::endl << "session load on one core: " << juce::String (100.0 * total (slow) / seconds, 1) << "% -> "
+              << juce::String (100.0 * total (fast) / seconds, 1) << "%" << std::endl;
+
+    auto difference = 0.0f;
+
+    for (auto channel = 0; channel < 2; ++channel)
+    {
+        auto* a = slow.mix.getReadPointer (channel);
+        auto* b = fast.mix.getReadPointer (channel);
+
+        for (auto i = 0; i < slow.mix.getNumSamples(); ++i)
+            difference = juce::jmax (difference, std::abs (a[i] - b[i]));
+    }
+
+    auto passed = difference == 0.0f;
+    std::cout << (passed ? "PASSED" : "FAILED") << ": mix with fast paths on "
+              << (passed ? juce::String ("identical") : "differs by up to " + juce::String (difference)) << std::endl;
+
+    // The envelopes stop falling 120 dB down while blocks are skipped, so this one allows for
+    // that; ramps left behind during the silence would be off by decibels
+    auto slowReturn = playChangeDuringSilence (source, blockSize, false, useSimd);
+    auto fastReturn = playChangeDuringSilence (source, blockSize, true, useSimd);
+    auto returnDifference = 0.0f;
+
+    for (auto channel = 0; channel < 2; ++channel)
+        for (auto i = 0; i < blockSize; ++i)
+            returnDifference = juce::jmax (returnDifference, std::abs (slowReturn.getSample (channel, i) - fastReturn.getSample (channel, i)));
+
+    auto returnPassed = returnDifference <= 1.0e-5f;
+    std::cout << (returnPassed ? "PASSED" : "FAILED") << ": first block after a change made during silence differs by "
+              << juce::String (juce::Decibels::gainToDecibels (returnDifference, -200.0f), 1) << " dBFS with fast paths on" << std::endl;
+
+    return passed && returnPassed ? 0 : 1;
+}
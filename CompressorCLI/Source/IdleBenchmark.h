@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    IdleBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** A mostly idle session: --tracks=200 stereo instances, of which --active=10 (%)
+    compress a signal, --unity=20 (%) play one at ratio 1 and 0 dB, and the rest
+    play a short clip and then sit on silence. Runs the session with the fast paths
+    off and on, prints the time per track class and for the whole session, and the
+    tail length reported. Then moves the threshold and gains while one instance sits
+    on silence and plays signal again. Returns non-zero if the session's output
+    differs between the two, or the first block back by more than -100 dBFS.
+*/
+int runIdleBenchmark (const CommandLine& commandLine);
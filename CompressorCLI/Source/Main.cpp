@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AccuracyCheck.h"
+#include "AutomationCheck.h"
+#include "BatchBenchmark.h"
+#include "BatchRender.h"
+#include "ChunkBenchmark.h"
+#include "EngineBenchmark.h"
+#include "HibernateBenchmark.h"
+#include "IdleBenchmark.h"
+#include "MemoryBenchmark.h"
+#include "MixerBenchmark.h"
+#include "PaintBenchmark.h"
+#include "ProcessBenchmark.h"
+#include "RealtimeCheck.h"
+#include "StateBenchmark.h"
+
+//==============================================================================
+static void printUsage()
+{
+    std::cout << "Usage: CompressorCLI <command> [options]" << std::endl << std::endl
+              << "Commands:" << std::endl
+              << "  render      Render audio files through the compressor on a thread pool" << std::endl
+              << "  engines     Compare the SIMD compressor kernel against juce::dsp::Compressor" << std::endl
+              << "  paint       Measure dial and editor paint cost, cached and uncached" << std::endl
+              << "  process     Benchmark processBlock across rates, block sizes and layouts (--json=file)" << std::endl
+              << "  rtcheck     Fail if processBlock allocates, locks or blocks (Debug builds)" << std::endl
+              << "  accuracy    Check each gain math tier against its stated dB error bound" << std::endl
+              << "  automation  Check that timestamped parameter changes land on their sample" << std::endl
+              << "  state       Time restoring saved states into 500 instances, compact and ValueTree" << std::endl
+              << "  chunking    Sweep host block sizes 1-8192 with and without internal chunking" << std::endl
+              << "  idle        Session CPU of 200 mostly idle tracks with the fast paths off and on" << std::endl
+              << "  memory      Memory per instance for 1, 100 and 500 instances, resources shared or not" << std::endl
+              << "  hibernate   Memory of 500 instances before and after releaseResources()" << std::endl
+              << "  mixer       Up to 1000 instances into buses on a work-stealing pool, 1 to all cores" << std::endl
+              << "  batch       Mono compressors as one BatchCompressor against separate instances" << std::endl;
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args (argv + 1, argc - 1);
+
+    if (args.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    auto command = args[0];
+    args.remove (0);
+    CommandLine commandLine (args);
+
+    if (command == "render")       return runBatchRender (commandLine);
+    if (command == "engines")      return runEngineBenchmark (commandLine);
+    if (command == "paint")        return runPaintBenchmark (commandLine);
+    if (command == "process")      return runProcessBenchmark (commandLine);
+    if (command == "rtcheck")      return runRealtimeCheck (commandLine);
+    if (command == "accuracy")     return runAccuracyCheck (commandLine);
+    if (command == "automation")   return runAutomationCheck (commandLine);
+    if (command == "state")        return runStateBenchmark (commandLine);
+    if (command == "chunking")     return runChunkBenchmark (commandLine);
+    if (command == "idle")         return runIdleBenchmark (commandLine);
+    if (command == "memory")       return runMemoryBenchmark (commandLine);
+    if (command == "hibernate")    return runHibernateBenchmark (commandLine);
+    if (command == "mixer")        return runMixerBenchmark (commandLine);
+    if (command == "batch")        return runBatchBenchmark (commandLine);
+
+    printUsage();
+    return 1;
+}
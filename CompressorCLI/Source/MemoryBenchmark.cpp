@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    MemoryBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "MemoryBenchmark.h"
+#include "MemoryUsage.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    struct Instance
+    {
+        std::unique_ptr<CompressorPrototyperAudioProcessor> processor;
+        std::unique_ptr<juce::AudioProcessorEditor> editor;
+    };
+
+    /** Writes numPresets random user presets into a scratch folder. */
+    juce::File makeLibrary (int numPresets)
+    {
+        auto directory = juce::File::createTempFile ("presets");
+        CompressorPrototyperAudioProcessor writer;
+        writer.setUserPresetDirectory (directory);
+        juce::Random random;
+
+        for (auto i = 0; i < numPresets; ++i)
+        {
+            for (auto* parameter : writer.getParameters())
+                parameter->setValueNotifyingHost (random.nextFloat());
+
+            writer.saveUserPreset ("User " + juce::String (i).paddedLeft ('0', 5));
+        }
+
+        return directory;
+    }
+
+    /** What a host does to open an instance in a session: prepare it, list its programs and open its editor. */
+    Instance openInstance (const juce::File& library, bool withEditor)
+    {
+        Instance instance;
+        instance.processor = std::make_unique<CompressorPrototyperAudioProcessor>();
+        instance.processor->setUserPresetDirectory (library);
+        prepareProcessor (*instance.processor, 2, 48000.0, 512);
+        instance.processor->getNumPrograms();
+
+        while (instance.processor->isLoadingUserPresets())
+            juce::Thread::sleep (1);
+
+        if (withEditor)
+        {
+            instance.editor.reset (instance.processor->createEditor());
+            juce::Image image (juce::Image::ARGB, instance.editor->getWidth(), instance.editor->getHeight(), true);
+            juce::Graphics g (image);
+            instance.editor->paintEntireComponent (g, true);
+        }
+
+        return instance;
+    }
+}
+
+//==============================================================================
+int runMemoryBenchmark (const CommandLine& commandLine)
+{
+    const auto withEditors = commandLine.getInt ("editors", 1) != 0;
+    const auto library = makeLibrary (juce::jmax (0, commandLine.getInt ("presets", 200)));
+
+    juce::Array<int> counts;
+
+    for (auto& token : juce::StringArray::fromTokens (commandLine.getOption ("instances", "1,100,500"), ",", {}))
+        counts.add (juce::jmax (1, token.getIntValue()));
+
+    std::cout << "Per instance: prepared for stereo at 48 kHz / 512, programs listed from "
+              << library.getNumberOfChildFiles (juce::File::findFiles) << " user presets"
+              << (withEditors ? ", editor painted once" : "") << std::endl << std::endl
+              << "  sharing   instances        heap / instance    resident / instance   shared resources" << std::endl;
+
+    for (auto shouldShare : { false, true })
+    {
+        SharedResources::setSharingEnabled (shouldShare);
+
+        for (auto count : counts)
+        {
+            releaseFreeHeap();
+            auto heapBefore = (double) getHeapBytes();
+            auto residentBefore = (double) getResidentBytes();
+
+            std::vector<Instance> instances;
+
+            for (auto i = 0; i < count; ++i)
+                instances.push_back (openInstance (library, withEditors));
+
+            auto heapPerInstance = ((double) getHeapBytes() - heapBefore) / count;
+            auto residentPerInstance = ((double) getResidentBytes() - residentBefore) / count;
+
+            std::cout << "  " << juce::String (shouldShare ? "on" : "off").paddedRight (' ', 8)
+                      << juce::String (count).paddedLeft (' ', 11)
+                      << formatBytes (heapPerInstance).paddedLeft (' ', 23)
+                      << formatBytes (residentPerInstance).paddedLeft (' ', 23)
+                      << juce::String (SharedResources::getNumResources()).paddedLeft (' ', 19) << std::endl;
+
+            // Editors go first, as a host closes them before their processors
+            for (auto& instance : instances)
+                instance.editor.reset();
+        }
+    }
+
+    SharedResources::setSharingEnabled (true);
+    library.deleteRecursively();
+    return 0;
+}
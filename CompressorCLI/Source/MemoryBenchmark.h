@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    MemoryBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Opens 1, 100 and 500 instances (--instances=1,100,500), each prepared, with an
+    editor painted once (--editors=0 to leave them out) and programs listed from a
+    user preset library of --presets=200 files. Prints the heap and resident memory
+    per instance with the shared resource registry off and on.
+*/
+int runMemoryBenchmark (const CommandLine& commandLine);
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    MemoryUsage.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#if JUCE_LINUX
+ #include <malloc.h>
+ #include <unistd.h>
+#endif
+
+//==============================================================================
+/** Bytes of the process currently resident in RAM, from /proc/self/statm; 0 where unavailable. */
+inline size_t getResidentBytes()
+{
+   #if JUCE_LINUX
+    auto fields = juce::StringArray::fromTokens (juce::File ("/proc/self/statm").loadFileAsString(), false);
+    return (size_t) fields[1].getLargeIntValue() * (size_t) sysconf (_SC_PAGESIZE);
+   #else
+    return 0;
+   #endif
+}
+
+/** Bytes handed out by malloc and not yet freed. Unlike the resident size, this
+    drops as soon as something is freed; 0 where unavailable.
+*/
+inline size_t getHeapBytes()
+{
+   #if JUCE_LINUX && defined (__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+   #elif JUCE_LINUX && defined (__GLIBC__)
+    auto info = mallinfo();
+    return (size_t) (unsigned int) info.uordblks + (size_t) (unsigned int) info.hblkhd;
+   #else
+    return 0;
+   #endif
+}
+
+/** Returns freed heap pages to the system, so the next resident size reflects what's in use. */
+inline void releaseFreeHeap()
+{
+   #if JUCE_LINUX && defined (__GLIBC__)
+    malloc_trim (0);
+   #endif
+}
+
+inline juce::String formatBytes (double bytes)
+{
+    if (std::abs (bytes) >= 1024.0 * 1024.0)
+        return juce::String (bytes / (1024.0 * 1024.0), 2) + " MB";
+
+    return juce::String (bytes / 1024.0, 1) + " kB";
+}
@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    MixerBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "MixerBenchmark.h"
+#include "ProcessorHarness.h"
+#include "WorkStealingPool.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numChannels = 2;
+
+    /** Tracks into buses into the master, one instance per track and per bus.
+
+        The pool runs one task per track, and the pool's thread that finishes a bus's
+        last track runs that bus. Buses and the master add their inputs in a fixed
+        order, so the output doesn't depend on which thread ran what.
+    */
+    class Mixer
+    {
+    public:
+        Mixer (int numTracksToUse, int numBusesToUse, int blockSizeToUse, const juce::AudioBuffer<float>& sourceToPlay)
+            : numTracks (numTracksToUse), numBuses (numBusesToUse), blockSize (blockSizeToUse), source (sourceToPlay),
+              trackBuffers ((size_t) numTracks), busBuffers ((size_t) numBuses), trackMidi ((size_t) numTracks),
+              busMidi ((size_t) numBuses), pendingTracks ((size_t) numBuses), master (numChannels, blockSize)
+        {
+            for (auto track = 0; track < numTracks; ++track)
+            {
+                // A spread of settings, so tracks don't all take the same branches
+                auto& processor = *tracks.emplace_back (std::make_unique<CompressorPrototyperAudioProcessor>());
+                setParameter (processor, threshSliderId, -30.0f + (float) (track % 5) * 5.0f);
+                setParameter (processor, ratioSliderId, 2.0f + (float) (track % 7));
+                setParameter (processor, attackSliderId, 1.0f + (float) (track % 11) * 2.0f);
+                prepareProcessor (processor, numChannels, sampleRate, blockSize);
+                trackBuffers[(size_t) track].setSize (numChannels, blockSize);
+            }
+
+            for (auto bus = 0; bus < numBuses; ++bus)
+            {
+                auto& processor = *buses.emplace_back (std::make_unique<CompressorPrototyperAudioProcessor>());
+                setParameter (processor, threshSliderId, -18.0f);
+                setParameter (processor, ratioSliderId, 2.0f);
+                prepareProcessor (processor, numChannels, sampleRate, blockSize);
+                busBuffers[(size_t) bus].setSize (numChannels, blockSize);
+            }
+
+            // Sums at equal power, so levels stay in range whatever the counts
+            trackGain = 1.0f / std::sqrt ((float) numTracks / (float) numBuses);
+            busGain = 1.0f / std::sqrt ((float) numBuses);
+        }
+
+        /** One audio callback; the result is in getMaster() afterwards. */
+        void process (WorkStealingPool& pool, int callback)
+        {
+            sourcePosition = (callback * blockSize) % (source.getNumSamples() - blockSize);
+
+            for (auto bus = 0; bus < numBuses; ++bus)
+                pendingTracks[(size_t) bus].store ((numTracks - bus + numBuses - 1) / numBuses, std::memory_order_relaxed);
+
+            pendingBuses.store (numBuses, std::memory_order_relaxed);
+            pool.run (numTracks, *this);
+        }
+
+        const juce::AudioBuffer<float>& getMaster() const noexcept      { return master; }
+
+        /** The pool's task: one track's block, then its bus if it's the last one in. */
+        void operator() (int track)
+        {
+            auto& buffer = trackBuffers[(size_t) track];
+
+            // Every track plays the same material from its own point in it
+            auto position = (sourcePosition + track * 9973) % (source.getNumSamples() - blockSize);
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+                buffer.copyFrom (channel, 0, source, channel, position, blockSize);
+
+            tracks[(size_t) track]->processBlock (buffer, trackMidi[(size_t) track]);
+
+            auto bus = track % numBuses;
+
+            if (pendingTracks[(size_t) bus].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                processBus (bus);
+        }
+
+    private:
+        void processBus (int bus)
+        {
+            auto& buffer = busBuffers[(size_t) bus];
+            buffer.clear();
+
+            for (auto track = bus; track < numTracks; track += numBuses)
+                for (auto channel = 0; channel < numChannels; ++channel)
+                    buffer.addFrom (channel, 0, trackBuffers[(size_t) track], channel, 0, blockSize, trackGain);
+
+            buses[(size_t) bus]->processBlock (buffer, busMidi[(size_t) bus]);
+
+            if (pendingBuses.fetch_sub (1, std::memory_order_acq_rel) == 1)
+                processMaster();
+        }
+
+        void processMaster()
+        {
+            master.clear();
+
+            for (auto& buffer : busBuffers)
+                for (auto channel = 0; channel < numChannels; ++channel)
+                    master.addFrom (channel, 0, buffer, channel, 0, blockSize, busGain);
+        }
+
+        const int numTracks, numBuses, blockSize;
+        const juce::AudioBuffer<float>& source;
+        int sourcePosition = 0;
+        float trackGain = 1.0f, busGain = 1.0f;
+
+        std::vector<std::unique_ptr<CompressorPrototyperAudioProcessor>> tracks, buses;
+        std::vector<juce::AudioBuffer<float>> trackBuffers, busBuffers;
+        std::vector<juce::MidiBuffer> trackMidi, busMidi;
+        std::vector<std::atomic<int>> pendingTracks;
+        std::atomic<int> pendingBuses { 0 };
+        juce::AudioBuffer<float> master;
+    };
+
+    struct MixerResult
+    {
+        double meanMicroseconds = 0.0, p99Microseconds = 0.0, maxMicroseconds = 0.0;
+        double stealsPerCallback = 0.0;
+        int numMisses = 0;
+        std::vector<float> output;
+    };
+
+    /** Paces callbacks at the block rate the way a sound card does, and times each one. */
+    MixerResult runMixer (int numThreads, int numTracks, int numBuses, int blockSize, double seconds,
+                          const juce::AudioBuffer<float>& source)
+    {
+        Mixer mixer (numTracks, numBuses, blockSize, source);
+        WorkStealingPool pool (numThreads);
+        MixerResult result;
+
+        const auto numCallbacks = juce::jmax (16, (int) (seconds * sampleRate) / blockSize);
+        const auto numWarmupCallbacks = juce::jmax (8, numCallbacks / 20);
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration> (std::chrono::duration<double> (blockSize / sampleRate));
+        const auto deadlineTicks = juce::Time::secondsToHighResolutionTicks (blockSize / sampleRate);
+
+        std::vector<juce::int64> callbackTicks ((size_t) numCallbacks);
+        result.output.reserve ((size_t) (numCallbacks * blockSize * numChannels));
+        juce::int64 totalTicks = 0, totalSteals = 0;
+
+        for (auto callback = -numWarmupCallbacks; callback < 0; ++callback)
+            mixer.process (pool, callback + numWarmupCallbacks);
+
+        auto nextCallback = std::chrono::steady_clock::now();
+
+        for (auto callback = 0; callback < numCallbacks; ++callback)
+        {
+            std::this_thread::sleep_until (nextCallback);
+
+            auto startTicks = juce::Time::getHighResolutionTicks();
+            mixer.process (pool, callback);
+            auto ticks = juce::Time::getHighResolutionTicks() - startTicks;
+
+            callbackTicks[(size_t) callback] = ticks;
+            totalTicks += ticks;
+            totalSteals += pool.getNumSteals();
+
+            if (ticks > deadlineTicks)
+                ++result.numMisses;
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+                result.output.insert (result.output.end(), mixer.getMaster().getReadPointer (channel),
+                                      mixer.getMaster().getReadPointer (channel) + blockSize);
+
+            // After an overrun the next callback starts at once, as the sound card would already be waiting
+            nextCallback = juce::jmax (nextCallback + period, std::chrono::steady_clock::now());
+        }
+
+        result.meanMicroseconds = juce::Time::highResolutionTicksToSeconds (totalTicks) * 1.0e6 / numCallbacks;
+        result.stealsPerCallback = (double) totalSteals / numCallbacks;
+
+        std::sort (callbackTicks.begin(), callbackTicks.end());
+        auto p99Index = juce::jmin (callbackTicks.size() - 1, (size_t) ((double) callbackTicks.size() * 0.99));
+        result.p99Microseconds = juce::Time::highResolutionTicksToSeconds (callbackTicks[p99Index]) * 1.0e6;
+        result.maxMicroseconds = juce::Time::highResolutionTicksToSeconds (callbackTicks.back()) * 1.0e6;
+        return result;
+    }
+}
+
+//==============================================================================
+int runMixerBenchmark (const CommandLine& commandLine)
+{
+    const auto numTracks = juce::jlimit (1, 1000, commandLine.getInt ("tracks", 256));
+    const auto numBuses = juce::jlimit (1, numTracks, commandLine.getInt ("buses", 16));
+    const auto blockSize = juce::jlimit (16, 8192, commandLine.getInt ("block", 256));
+    const auto seconds = commandLine.getDouble ("seconds", 5.0);
+    const auto numCores = juce::SystemStats::getNumCpus();
+
+    juce::Array<int> threadCounts;
+
+    for (auto& token : juce::StringArray::fromTokens (commandLine.getOption ("threads"), ",", {}))
+        if (token.getIntValue() > 0)
+            threadCounts.addIfNotAlreadyThere (token.getIntValue());
+
+    if (threadCounts.isEmpty())
+    {
+        for (auto numThreads = 1; numThreads < numCores; numThreads *= 2)
+            threadCounts.add (numThreads);
+
+        threadCounts.addIfNotAlreadyThere (numCores);
+    }
+
+    // Ten seconds of noise under a slow swell, so the compressors move in and out of gain reduction
+    juce::Random random (commandLine.getInt ("seed", 1));
+    juce::AudioBuffer<float> source (numChannels, (int) (10.0 * sampleRate));
+    fillWithNoise (source, random);
+
+    for (auto channel = 0; channel < numChannels; ++channel)
+        for (auto i = 0; i < source.getNumSamples(); ++i)
+            source.setSample (channel, i, source.getSample (channel, i)
+                                            * (0.55f + 0.45f * std::sin (juce::MathConstants<float>::twoPi * 0.7f * (float) i / (float) sampleRate)));
+
+    const auto deadlineMicroseconds = 1.0e6 * blockSize / sampleRate;
+
+    std::cout << numTracks << " stereo tracks into " << numBuses << " buses at 48 kHz / " << blockSize
+              << " (deadline " << juce::String (deadlineMicroseconds, 1) << " us), " << numCores << " cores, "
+              << seconds << " s per run" << std::endl << std::endl
+              << "threads   mean us    p99 us    max us  misses  p99 load  steals/cb  speedup  efficiency  output" << std::endl;
+
+    MixerResult reference;
+    auto allIdentical = true;
+
+    for (auto numThreads : threadCounts)
+    {
+        auto result = runMixer (numThreads, numTracks, numBuses, blockSize, seconds, source);
+        auto isReference = reference.output.empty();
+
+        if (isReference)
+            reference = result;
+
+        auto identical = result.output == reference.output;
+        allIdentical = allIdentical && identical;
+
+        // Against the first run, so an explicit --threads list without 1 still reads sensibly
+        auto speedup = reference.meanMicroseconds / result.meanMicroseconds;
+        auto efficiency = speedup * threadCounts.getFirst() / numThreads;
+
+        std::cout << juce::String (numThreads).paddedLeft (' ', 7)
+                  << juce::String (result.meanMicroseconds, 1).paddedLeft (' ', 10)
+                  << juce::String (result.p99Microseconds, 1).paddedLeft (' ', 10)
+                  << juce::String (result.maxMicroseconds, 1).paddedLeft (' ', 10)
+                  << juce::String (result.numMisses).paddedLeft (' ', 8)
+                  << (juce::String (result.p99Microseconds / deadlineMicroseconds * 100.0, 1) + "%").paddedLeft (' ', 10)
+                  << juce::String (result.stealsPerCallback, 1).paddedLeft (' ', 11)
+                  << (juce::String (speedup, 2) + "x").paddedLeft (' ', 9)
+                  << (juce::String (efficiency * 100.0, 1) + "%").paddedLeft (' ', 12)
+                  << "  " << (isReference ? "reference" : (identical ? "identical" : "DIFFERS")) << std::endl;
+    }
+
+    if (! allIdentical)
+    {
+        std::cout << std::endl << "FAILED: the mix depends on the thread count" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+/*
+  ==============================================================================
+
+    MixerBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** A host-style mixer: --tracks=256 stereo instances (at most 1000) summed in
+    order into --buses=16 buses, each with its own instance, then into the master.
+    Every audio callback of --block=256 samples at 48 kHz runs the tracks on a
+    work-stealing pool. The last track into a bus runs that bus, and the last bus
+    runs the master. Callbacks are paced in real time for --seconds=5 at each of
+    --threads (default 1, 2, 4 ... up to every core).
+
+    Prints deadline misses, mean, p99 and max callback time, and speedup and
+    scaling efficiency against the first thread count. Returns non-zero if any
+    thread count's output differs from the first one's.
+*/
+int runMixerBenchmark (const CommandLine& commandLine);
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    PaintBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PaintBenchmark.h"
+#include "../../CompressorPrototyper/Source/PluginEditor.h"
+
+namespace
+{
+    /** Six dials styled like the editor's, drawn either the old way or from the cache. */
+    struct DialBank  : public juce::Component
+    {
+        DialBank (bool useLegacyDrawing)
+        {
+            dial.setImageCacheEnabled (! useLegacyDrawing);
+            shadowEffect.setShadowProperties (juce::DropShadow (juce::Colour (0x90000000), 15, { -2, 6 }));
+
+            for (auto& slider : sliders)
+            {
+                addAndMakeVisible (slider);
+                slider.setSliderStyle (juce::Slider::SliderStyle::RotaryVerticalDrag);
+                slider.setTextBoxStyle (juce::Slider::TextBoxBelow, false, 64, 32);
+                slider.setRange (-36, 36, 0.5f);
+                slider.setLookAndFeel (&dial);
+
+                if (useLegacyDrawing)
+                    slider.setComponentEffect (&shadowEffect);
+            }
+
+            setSize (711, 237);
+        }
+
+        ~DialBank() override
+        {
+            for (auto& slider : sliders)
+                slider.setLookAndFeel (nullptr);
+        }
+
+        void resized() override
+        {
+            auto area = getLocalBounds().withTrimmedTop (getHeight() / 4).withHeight (getHeight() / 2);
+            auto width = getWidth() / (int) sliders.size();
+
+            for (auto& slider : sliders)
+                slider.setBounds (area.removeFromLeft (width));
+        }
+
+        ViatorDial dial;
+        juce::DropShadowEffect shadowEffect;
+        std::array<juce::Slider, 6> sliders;
+    };
+
+    /** Average microseconds per call of paintOnce, rendering into an image at the given scale. */
+    template <typename PaintFunction>
+    double microsecondsPerPaint (juce::Rectangle<int> area, float scale, int numIterations, PaintFunction&& paintOnce)
+    {
+        juce::Image image (juce::Image::ARGB, juce::roundToInt (area.getWidth() * scale), juce::roundToInt (area.getHeight() * scale), true);
+        juce::Graphics g (image);
+        g.addTransform (juce::AffineTransform::scale (scale));
+
+        paintOnce (g, 0); // warm up any caches, as the first real paint would
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (auto i = 1; i <= numIterations; ++i)
+            paintOnce (g, i);
+
+        return juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start) * 1.0e6 / numIterations;
+    }
+
+    void benchmarkDials (bool useLegacyDrawing, float scale, int numIterations)
+    {
+        DialBank bank (useLegacyDrawing);
+        auto& dragged = bank.sliders.front();
+
+        // A knob drag repaints just that slider with a new value every frame
+        auto dragTime = microsecondsPerPaint (dragged.getLocalBounds(), scale, numIterations, [&] (juce::Graphics& g, int i)
+        {
+            dragged.setValue (-36.0 + (i % 144) * 0.5, juce::dontSendNotification);
+            dragged.paintEntireComponent (g, true);
+        });
+
+        auto fullTime = microsecondsPerPaint (bank.getLocalBounds(), scale, numIterations, [&] (juce::Graphics& g, int)
+        {
+            bank.paintEntireComponent (g, true);
+        });
+
+        std::cout << (useLegacyDrawing ? "uncached + DropShadowEffect" : "cached body              ")
+                  << "  scale " << scale << "   drag frame " << juce::String (dragTime, 1).paddedLeft (' ', 8) << " us"
+                  << "   all six dials " << juce::String (fullTime, 1).paddedLeft (' ', 8) << " us" << std::endl;
+    }
+}
+
+//==============================================================================
+int runPaintBenchmark (const CommandLine& commandLine)
+{
+    const auto numIterations = juce::jmax (1, commandLine.getInt ("iterations", 500));
+
+    for (auto scale : { 1.0f, 2.0f })
+    {
+        benchmarkDials (true, scale, numIterations);
+        benchmarkDials (false, scale, numIterations);
+    }
+
+    CompressorPrototyperAudioProcessor processor;
+    std::unique_ptr<juce::AudioProcessorEditor> editor (processor.createEditor());
+
+    for (auto scale : { 1.0f, 2.0f })
+    {
+        auto editorTime = microsecondsPerPaint (editor->getLocalBounds(), scale, numIterations, [&] (juce::Graphics& g, int)
+        {
+            editor->paintEntireComponent (g, true);
+        });
+
+        std::cout << "full editor  scale " << scale << "   " << juce::String (editorTime, 1) << " us per paint" << std::endl;
+    }
+
+    return 0;
+}
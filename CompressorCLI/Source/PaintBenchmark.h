@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    PaintBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Renders the dials and the whole editor into offscreen images, without a
+    display, and reports the cost of each paint with the ViatorDial image cache
+    on and with the old uncached drawing plus DropShadowEffect.
+*/
+int runPaintBenchmark (const CommandLine& commandLine);
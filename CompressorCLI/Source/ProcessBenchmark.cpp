@@ -0,0 +1,294 @@
+/*
+  ==============================================================================
+
+    ProcessBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ProcessBenchmark.h"
+#include "ProcessorHarness.h"
+
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #include <x86intrin.h>
+#elif JUCE_INTEL && JUCE_MSVC
+ #include <intrin.h>
+#endif
+
+namespace
+{
+    /** Time-stamp counter where the CPU has one, 0 elsewhere (cycles are then
+        estimated from the nominal clock speed).
+    */
+    juce::uint64 readCycleCounter() noexcept
+    {
+       #if JUCE_INTEL
+        return (juce::uint64) __rdtsc();
+       #else
+        return 0;
+       #endif
+    }
+
+    /** One point in the sweep. */
+    struct Configuration
+    {
+        bool useSimd = true;
+        double sampleRate = 48000.0;
+        int blockSize = 512, numChannels = 2;
+        bool automated = false;
+        int oversamplingFactor = 1;
+        bool linearPhase = false;
+        int numBands = 1;
+        bool doublePrecision = false;
+        bool linkedDetector = false;
+
+        juce::String getEngineName() const      { return useSimd ? "simd" : "juce"; }
+        juce::String getFilterName() const      { return oversamplingFactor == 1 ? "-" : (linearPhase ? "fir" : "iir"); }
+        juce::String getPrecisionName() const   { return doublePrecision ? "double" : "float"; }
+        juce::String getDetectorName() const    { return linkedDetector ? "linked" : "channel"; }
+    };
+
+    struct BenchmarkResult
+    {
+        Configuration config;
+        int latencySamples = 0;
+        double nanosecondsPerSample = 0.0, cyclesPerSample = 0.0;
+        double p99Microseconds = 0.0, maxMicroseconds = 0.0, deadlineMicroseconds = 0.0;
+
+        double p99Load() const noexcept     { return p99Microseconds / deadlineMicroseconds; }
+
+        juce::var toVar() const
+        {
+            auto* object = new juce::DynamicObject();
+            object->setProperty ("engine", config.getEngineName());
+            object->setProperty ("sampleRate", config.sampleRate);
+            object->setProperty ("blockSize", config.blockSize);
+            object->setProperty ("channels", config.numChannels);
+            object->setProperty ("automated", config.automated);
+            object->setProperty ("oversampling", config.oversamplingFactor);
+            object->setProperty ("oversamplingFilter", config.getFilterName());
+            object->setProperty ("bands", config.numBands);
+            object->setProperty ("precision", config.getPrecisionName());
+            object->setProperty ("detector", config.getDetectorName());
+            object->setProperty ("latencySamples", latencySamples);
+            object->setProperty ("nsPerSample", nanosecondsPerSample);
+            object->setProperty ("cyclesPerSample", cyclesPerSample);
+            object->setProperty ("p99BlockMicroseconds", p99Microseconds);
+            object->setProperty ("maxBlockMicroseconds", maxMicroseconds);
+            object->setProperty ("deadlineMicroseconds", deadlineMicroseconds);
+            object->setProperty ("p99DeadlineFraction", p99Load());
+            return object;
+        }
+    };
+
+    juce::Array<int> parseList (const CommandLine& commandLine, const juce::String& name, const juce::String& fallback)
+    {
+        juce::Array<int> values;
+
+        for (auto& token : juce::StringArray::fromTokens (commandLine.getOption (name, fallback), ",", {}))
+            if (token.getIntValue() > 0)
+                values.add (token.getIntValue());
+
+        return values;
+    }
+
+    //==============================================================================
+    /** Times every block after a short warm-up, in the processor's current precision. */
+    template <typename SampleType>
+    void measureBlocks (CompressorPrototyperAudioProcessor& processor, const Configuration& config, double seconds,
+                        juce::Random& random, BenchmarkResult& result)
+    {
+        juce::AudioBuffer<SampleType> buffer (config.numChannels, config.blockSize);
+        juce::MidiBuffer midiMessages;
+
+        auto numBlocks = juce::jmax (16, (int) (seconds * config.sampleRate) / config.blockSize);
+        auto numWarmupBlocks = juce::jmax (4, numBlocks / 20);
+        std::vector<juce::int64> blockTicks ((size_t) numBlocks);
+
+        juce::int64 totalTicks = 0;
+        juce::uint64 totalCycles = 0;
+
+        for (auto i = -numWarmupBlocks; i < numBlocks; ++i)
+        {
+            // Fresh noise every block so the detector never settles on a repeated pattern
+            fillWithNoise (buffer, random);
+
+            // Host-style automation: every block moves the threshold, ratio and attack
+            // along slow ramps so each one forces the engines to recompute coefficients.
+            if (config.automated)
+            {
+                auto phase = (float) (i & 255) / 255.0f;
+                setParameter (processor, threshSliderId, -30.0f + 20.0f * phase);
+                setParameter (processor, ratioSliderId, 2.0f + 6.0f * phase);
+                setParameter (processor, attackSliderId, 1.0f + 20.0f * phase);
+            }
+
+            auto startCycles = readCycleCounter();
+            auto startTicks = juce::Time::getHighResolutionTicks();
+
+            processor.processBlock (buffer, midiMessages);
+
+            auto ticks = juce::Time::getHighResolutionTicks() - startTicks;
+            auto cycles = readCycleCounter() - startCycles;
+
+            if (i < 0)
+                continue;
+
+            blockTicks[(size_t) i] = ticks;
+            totalTicks += ticks;
+            totalCycles += cycles;
+        }
+
+        // Per input sample at the host rate, so oversampled runs compare directly
+        auto totalSamples = (double) numBlocks * config.blockSize * config.numChannels;
+        result.nanosecondsPerSample = juce::Time::highResolutionTicksToSeconds (totalTicks) * 1.0e9 / totalSamples;
+        result.cyclesPerSample = totalCycles > 0 ? (double) totalCycles / totalSamples
+                                                 : result.nanosecondsPerSample * juce::SystemStats::getCpuSpeedInMegahertz() / 1000.0;
+
+        std::sort (blockTicks.begin(), blockTicks.end());
+        auto p99Index = juce::jmin (blockTicks.size() - 1, (size_t) ((double) blockTicks.size() * 0.99));
+        result.p99Microseconds = juce::Time::highResolutionTicksToSeconds (blockTicks[p99Index]) * 1.0e6;
+        result.maxMicroseconds = juce::Time::highResolutionTicksToSeconds (blockTicks.back()) * 1.0e6;
+    }
+
+    BenchmarkResult runConfiguration (const Configuration& config, double seconds, juce::Random& random)
+    {
+        BenchmarkResult result { config };
+        result.deadlineMicroseconds = 1.0e6 * config.blockSize / config.sampleRate;
+
+        CompressorPrototyperAudioProcessor processor;
+        processor.setUseSimdCompressor (config.useSimd);
+        processor.setProcessingPrecision (config.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                 : juce::AudioProcessor::singlePrecision);
+        setParameter (processor, threshSliderId, -24.0f);
+        setParameter (processor, ratioSliderId, 4.0f);
+        setParameter (processor, oversamplingSliderId, (float) juce::roundToInt (std::log2 (config.oversamplingFactor)));
+        setParameter (processor, oversamplingFilterSliderId, config.linearPhase ? 1.0f : 0.0f);
+        setParameter (processor, bandsSliderId, (float) config.numBands);
+
+        // Linked max over LCR / surrounds / heights with the LFE on its own, the usual film setup
+        setParameter (processor, detectorSliderId, config.linkedDetector ? 1.0f : 0.0f);
+        setParameter (processor, linkGroupsSliderId, config.linkedDetector ? 2.0f : 0.0f);
+
+        if (! prepareProcessor (processor, config.numChannels, config.sampleRate, config.blockSize))
+            return {};
+
+        result.latencySamples = processor.getLatencySamples();
+
+        if (config.doublePrecision)
+            measureBlocks<double> (processor, config, seconds, random, result);
+        else
+            measureBlocks<float> (processor, config, seconds, random, result);
+
+        processor.releaseResources();
+        return result;
+    }
+}
+
+//==============================================================================
+int runProcessBenchmark (const CommandLine& commandLine)
+{
+    const auto seconds = commandLine.getDouble ("seconds", 2.0);
+    const auto blockSizes = parseList (commandLine, "blocks", "16,32,64,128,256,512,1024,2048,4096");
+    const auto sampleRates = parseList (commandLine, "rates", "44100,48000,96000,192000");
+    auto channelCounts = parseList (commandLine, "channels", "1,2,6,8");
+    const auto engine = commandLine.getOption ("engine", "both");
+
+    juce::Array<bool> engines;
+    if (engine != "juce")   engines.add (true);
+    if (engine != "simd")   engines.add (false);
+
+    juce::Array<int> oversamplingFactors;
+    for (auto factor : parseList (commandLine, "oversampling", "1"))
+        if (juce::isPowerOfTwo (factor) && factor <= 8)
+            oversamplingFactors.add (factor);
+
+    const auto filters = juce::StringArray::fromTokens (commandLine.getOption ("filter", "iir"), ",", {});
+    const auto bandCounts = parseList (commandLine, "bands", "1");
+    const auto precisions = juce::StringArray::fromTokens (commandLine.getOption ("precision", "float"), ",", {});
+    const auto detectors = juce::StringArray::fromTokens (commandLine.getOption ("detector", "channel"), ",", {});
+
+    {
+        CompressorPrototyperAudioProcessor probe;
+
+        for (auto numChannels : juce::Array<int> (channelCounts))
+        {
+            if (! probe.checkBusesLayoutSupported (mainBusLayout (probe, numChannels)))
+            {
+                std::cout << numChannels << " channels not supported by this build, skipped" << std::endl;
+                channelCounts.removeFirstMatchingValue (numChannels);
+            }
+        }
+    }
+
+    std::cout << "CPU: " << juce::SystemStats::getCpuModel() << " (" << juce::SystemStats::getCpuSpeedInMegahertz() << " MHz), "
+              << (readCycleCounter() != 0 ? "cycles from TSC" : "cycles estimated from clock speed") << std::endl
+              << "engine  precision  detector     rate  block  ch  auto  os  filter  bands  latency   ns/sample  cycles/sample   p99 us   max us  deadline us  p99 load" << std::endl;
+
+    juce::Array<juce::var> results;
+    juce::Random random;
+    auto numOverDeadline = 0;
+
+    auto run = [&] (const Configuration& config)
+    {
+        auto result = runConfiguration (config, seconds, random);
+
+        if (result.p99Load() > 1.0)
+            ++numOverDeadline;
+
+        std::cout << config.getEngineName().paddedRight (' ', 8) << config.getPrecisionName().paddedRight (' ', 11)
+                  << config.getDetectorName().paddedRight (' ', 10)
+                  << juce::String (config.sampleRate).paddedLeft (' ', 7)
+                  << juce::String (config.blockSize).paddedLeft (' ', 7) << juce::String (config.numChannels).paddedLeft (' ', 4)
+                  << juce::String (config.automated ? "yes" : "no").paddedLeft (' ', 6)
+                  << (juce::String (config.oversamplingFactor) + "x").paddedLeft (' ', 4)
+                  << config.getFilterName().paddedLeft (' ', 8) << juce::String (config.numBands).paddedLeft (' ', 7)
+                  << juce::String (result.latencySamples).paddedLeft (' ', 9)
+                  << juce::String (result.nanosecondsPerSample, 3).paddedLeft (' ', 12)
+                  << juce::String (result.cyclesPerSample, 1).paddedLeft (' ', 15)
+                  << juce::String (result.p99Microseconds, 1).paddedLeft (' ', 9)
+                  << juce::String (result.maxMicroseconds, 1).paddedLeft (' ', 9)
+                  << juce::String (result.deadlineMicroseconds, 1).paddedLeft (' ', 13)
+                  << (juce::String (result.p99Load() * 100.0, 2) + "%").paddedLeft (' ', 10) << std::endl;
+
+        results.add (result.toVar());
+    };
+
+    for (auto useSimd : engines)
+        for (auto& precision : precisions)
+            for (auto& detector : detectors)
+                for (auto sampleRate : sampleRates)
+                    for (auto numChannels : channelCounts)
+                        for (auto blockSize : blockSizes)
+                            for (auto factor : oversamplingFactors)
+                                for (auto& filter : factor == 1 ? juce::StringArray ("iir") : filters)
+                                    for (auto numBands : bandCounts)
+                                        for (auto automated : { false, true })
+                                            run ({ useSimd, (double) sampleRate, blockSize, numChannels, automated,
+                                                   factor, filter == "fir", numBands, precision == "double", detector == "linked" });
+
+    if (commandLine.hasOption ("json"))
+    {
+        auto* report = new juce::DynamicObject();
+        report->setProperty ("cpu", juce::SystemStats::getCpuModel());
+        report->setProperty ("cpuMHz", juce::SystemStats::getCpuSpeedInMegahertz());
+        report->setProperty ("secondsPerConfiguration", seconds);
+        report->setProperty ("results", results);
+
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile (commandLine.getOption ("json"));
+
+        if (! file.replaceWithText (juce::JSON::toString (juce::var (report))))
+        {
+            std::cerr << "Couldn't write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::cout << "Wrote " << results.size() << " results to " << file.getFullPathName() << std::endl;
+    }
+
+    if (numOverDeadline > 0)
+        std::cout << numOverDeadline << " configurations had a p99 block time over the realtime deadline" << std::endl;
+
+    return 0;
+}
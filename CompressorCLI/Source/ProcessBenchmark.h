@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    ProcessBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Drives the whole plugin processBlock across block sizes, sample rates,
+    channel layouts, engines and oversampling modes, with and without per-block
+    automation, and reports ns/sample, cycles/sample and the p99 block time
+    against the realtime deadline. --json=file writes every result for scripted
+    comparison.
+*/
+int runProcessBenchmark (const CommandLine& commandLine);
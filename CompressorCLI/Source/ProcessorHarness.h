@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    ProcessorHarness.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../CompressorPrototyper/Source/PluginProcessor.h"
+
+//==============================================================================
+/** The processor's current layout with the main buses set to the given channel
+    count and any sidechain disabled.
+*/
+inline juce::AudioProcessor::BusesLayout mainBusLayout (const CompressorPrototyperAudioProcessor& processor, int numChannels)
+{
+    auto channelSet = juce::AudioChannelSet::canonicalChannelSet (numChannels);
+    auto layout = processor.getBusesLayout();
+    layout.inputBuses.getReference (0) = channelSet;
+    layout.outputBuses.getReference (0) = channelSet;
+
+    for (auto bus = 1; bus < layout.inputBuses.size(); ++bus)
+        layout.inputBuses.getReference (bus) = juce::AudioChannelSet::disabled();
+
+    return layout;
+}
+
+/** Does what a host would before playback: applies mainBusLayout() and calls
+    prepareToPlay. Returns false if the processor doesn't support that layout.
+*/
+inline bool prepareProcessor (CompressorPrototyperAudioProcessor& processor, int numChannels, double sampleRate, int blockSize)
+{
+    if (! processor.setBusesLayout (mainBusLayout (processor, numChannels)))
+        return false;
+
+    processor.setRateAndBufferSizeDetails (sampleRate, blockSize);
+    processor.prepareToPlay (sampleRate, blockSize);
+    return true;
+}
+
+template <typename SampleType>
+void fillWithNoise (juce::AudioBuffer<SampleType>& buffer, juce::Random& random, float level = 0.5f)
+{
+    for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        auto* samples = buffer.getWritePointer (channel);
+
+        for (auto i = 0; i < buffer.getNumSamples(); ++i)
+            samples[i] = (SampleType) ((random.nextFloat() * 2.0f - 1.0f) * level);
+    }
+}
+
+/** Moves a parameter the way host automation does, in real-world units. */
+inline void setParameter (CompressorPrototyperAudioProcessor& processor, const juce::String& parameterID, float value)
+{
+    if (auto* param = processor.treeState.getParameter (parameterID))
+        param->setValueNotifyingHost (param->convertTo0to1 (value));
+}
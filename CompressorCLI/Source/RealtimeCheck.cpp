@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeCheck.h"
+#include "RealtimeChecker.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    /** Stands in for a host, so anything that notifies the host from processBlock
+        goes through the same listener lock a real wrapper would take.
+    */
+    struct HostListener  : public juce::AudioProcessorListener
+    {
+        void audioProcessorParameterChanged (juce::AudioProcessor*, int, float) override {}
+        void audioProcessorChanged (juce::AudioProcessor*, const ChangeDetails&) override {}
+    };
+
+    /** Moves a few random parameters, the way automation lanes would. */
+    void automateParameters (CompressorPrototyperAudioProcessor& processor, juce::Random& random)
+    {
+        auto& parameters = processor.getParameters();
+
+        for (auto i = 0; i < 3; ++i)
+            parameters[random.nextInt (parameters.size())]->setValueNotifyingHost (random.nextFloat());
+    }
+
+    /** A handful of saved sessions with random settings to restore from, half of
+        them in the ValueTree format older versions saved.
+    */
+    std::vector<juce::MemoryBlock> makeStates (juce::Random& random)
+    {
+        std::vector<juce::MemoryBlock> states (8);
+        CompressorPrototyperAudioProcessor source;
+
+        for (size_t i = 0; i < states.size(); ++i)
+        {
+            for (auto* parameter : source.getParameters())
+                parameter->setValueNotifyingHost (random.nextFloat());
+
+            if (i % 2 == 0)
+            {
+                source.getStateInformation (states[i]);
+            }
+            else
+            {
+                juce::MemoryOutputStream stream (states[i], false);
+                source.treeState.copyState().writeToStream (stream);
+            }
+        }
+
+        return states;
+    }
+
+    //==============================================================================
+    class AudioThread  : public juce::Thread
+    {
+    public:
+        AudioThread (CompressorPrototyperAudioProcessor& p, int numChannels, int samplesPerBlock)
+            : juce::Thread ("Audio"), processor (p), buffer (numChannels, samplesPerBlock), numPrograms (p.getNumPrograms())
+        {
+            juce::Random random;
+            fillWithNoise (buffer, random);
+        }
+
+        void run() override
+        {
+            juce::MidiBuffer midiMessages;
+
+            while (! threadShouldExit())
+            {
+                // Hosts can change programs on the audio thread, so that has to be realtime safe too
+                if (numBlocks % 32 == 16)
+                {
+                    RealtimeScope realtimeScope;
+                    processor.setCurrentProgram ((numBlocks / 32) % numPrograms);
+                }
+
+                processor.processBlock (buffer, midiMessages);
+                ++numBlocks;
+            }
+        }
+
+        std::atomic<int> numBlocks { 0 };
+
+    private:
+        CompressorPrototyperAudioProcessor& processor;
+        juce::AudioBuffer<float> buffer;
+        int numPrograms;
+    };
+
+    //==============================================================================
+    /** Automation, plus a state restore or an A/B recall every 32 blocks, between blocks on the audio thread. */
+    int runInterleaved (CompressorPrototyperAudioProcessor& processor, const std::vector<juce::MemoryBlock>& states,
+                        int numChannels, int blockSize, int numBlocks, juce::Random& random)
+    {
+        juce::AudioBuffer<float> buffer (numChannels, blockSize);
+        juce::MidiBuffer midiMessages;
+
+        for (auto i = 0; i < numBlocks; ++i)
+        {
+            automateParameters (processor, random);
+
+            if (i % 64 == 0)
+            {
+                auto& state = states[(size_t) random.nextInt ((int) states.size())];
+                processor.setStateInformation (state.getData(), (int) state.getSize());
+            }
+            else if (i % 64 == 32)
+            {
+                processor.recallSnapshot (random.nextInt (CompressorPrototyperAudioProcessor::numSnapshots));
+            }
+
+            fillWithNoise (buffer, random);
+            processor.processBlock (buffer, midiMessages);
+        }
+
+        return numBlocks;
+    }
+
+    /** The same automation and restores, plus A/B recalls, made from this thread while another one runs processBlock. */
+    int runConcurrent (CompressorPrototyperAudioProcessor& processor, const std::vector<juce::MemoryBlock>& states,
+                       int numChannels, int blockSize, double seconds, juce::Random& random)
+    {
+        AudioThread audioThread (processor, numChannels, blockSize);
+        audioThread.startThread (juce::Thread::realtimeAudioPriority);
+
+        auto endTime = juce::Time::getMillisecondCounterHiRes() + seconds * 1000.0;
+        juce::MemoryBlock savedState;
+
+        for (auto i = 0; juce::Time::getMillisecondCounterHiRes() < endTime; ++i)
+        {
+            automateParameters (processor, random);
+
+            if (i % 16 == 0)
+            {
+                auto& state = states[(size_t) random.nextInt ((int) states.size())];
+                processor.setStateInformation (state.getData(), (int) state.getSize());
+                processor.getStateInformation (savedState);
+            }
+
+            if (i % 16 == 8)
+            {
+                processor.storeSnapshot (i % 32 == 8 ? 0 : 1);
+                processor.recallSnapshot (random.nextInt (CompressorPrototyperAudioProcessor::numSnapshots));
+            }
+
+            juce::Thread::sleep (1);
+        }
+
+        audioThread.stopThread (1000);
+        return audioThread.numBlocks;
+    }
+}
+
+//==============================================================================
+int runRealtimeCheck (const CommandLine& commandLine)
+{
+    if (! RealtimeChecker::isAvailable())
+    {
+        std::cerr << "The realtime checker isn't in this build: use the Debug configuration "
+                     "(VIATOR_REALTIME_CHECKS=1) on Linux." << std::endl;
+        return 1;
+    }
+
+    const auto sampleRate = commandLine.getDouble ("rate", 48000.0);
+    const auto blockSize = juce::jmax (1, commandLine.getInt ("block", 256));
+    const auto seconds = commandLine.getDouble ("seconds", 2.0);
+    const auto numBlocks = juce::jmax (64, (int) (seconds * sampleRate) / blockSize);
+
+    RealtimeChecker::setTrapOnViolation (commandLine.hasOption ("trap"));
+
+    juce::Random random (commandLine.getInt ("seed", 1));
+    auto states = makeStates (random);
+    auto totalViolations = 0;
+
+    for (auto useSimd : { true, false })
+    {
+        for (auto numChannels : { 1, 2, 6 })
+        {
+            CompressorPrototyperAudioProcessor processor;
+            HostListener host;
+            processor.addListener (&host);
+            processor.setUseSimdCompressor (useSimd);
+
+            if (! prepareProcessor (processor, numChannels, sampleRate, blockSize))
+                continue;
+
+            auto check = [&] (const char* scenario, int blocksRun)
+            {
+                auto numViolations = RealtimeChecker::getNumViolations();
+                totalViolations += numViolations;
+
+                std::cout << (useSimd ? "simd" : "juce") << ", " << numChannels << " ch, " << scenario << ": "
+                          << blocksRun << " blocks, " << numViolations << " violations" << std::endl;
+
+                RealtimeChecker::resetViolations();
+            };
+
+            RealtimeChecker::resetViolations();
+            check ("interleaved", runInterleaved (processor, states, numChannels, blockSize, numBlocks, random));
+            check ("concurrent", runConcurrent (processor, states, numChannels, blockSize, seconds, random));
+
+            processor.releaseResources();
+            processor.removeListener (&host);
+        }
+    }
+
+    std::cout << (totalViolations == 0 ? "PASSED" : "FAILED") << ": " << totalViolations
+              << " realtime violations inside processBlock" << std::endl;
+
+    return totalViolations == 0 ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Runs processBlock under the RealtimeChecker while parameters are automated
+    and state is restored, first interleaved on one thread and then from a
+    concurrent "message thread". Returns non-zero if anything inside
+    processBlock allocated, locked or blocked.
+*/
+int runRealtimeCheck (const CommandLine& commandLine);
@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    RealtimeChecker.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+// This file replaces libc functions, so it mustn't see the fortified inline
+// wrappers or anything from JUCE that might call back into them.
+#undef _FORTIFY_SOURCE
+
+#include "RealtimeChecker.h"
+#include "../../CompressorPrototyper/Source/RealtimeScope.h"
+
+#include <atomic>
+
+#if VIATOR_REALTIME_CHECKS && defined (__linux__) && defined (__GLIBC__)
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void* __libc_memalign (size_t, size_t);
+    void __libc_free (void*);
+}
+
+namespace
+{
+    std::atomic<int> numViolations { 0 };
+    std::atomic<bool> trapOnViolation { false };
+    constexpr int maxReportedViolations = 16;
+
+    // Set while reporting, so the printing and backtrace code can allocate and lock freely
+    thread_local bool isReporting = false;
+
+    void reportViolation (const char* function) noexcept
+    {
+        if (isReporting || ! RealtimeScope::isActive())
+            return;
+
+        isReporting = true;
+
+        if (++numViolations <= maxReportedViolations)
+        {
+            std::fprintf (stderr, "\n*** Realtime violation: %s() called inside a realtime scope\n", function);
+
+            void* frames[64];
+            auto numFrames = backtrace (frames, 64);
+            backtrace_symbols_fd (frames + 1, numFrames - 1, STDERR_FILENO);
+        }
+
+        if (trapOnViolation)
+            std::abort();
+
+        isReporting = false;
+    }
+
+    /** The next definition of a symbol we've replaced. Resolved without a static
+        guard, because the guard itself may take a mutex. A version picks that one
+        of a versioned symbol, where plain dlsym may return the oldest.
+    */
+    void* nextSymbol (const char* name, const char* version, std::atomic<void*>& cached) noexcept
+    {
+        auto function = cached.load (std::memory_order_acquire);
+
+        if (function == nullptr)
+        {
+            function = version != nullptr ? dlvsym (RTLD_NEXT, name, version) : nullptr;
+
+            if (function == nullptr)
+                function = dlsym (RTLD_NEXT, name);
+
+            cached.store (function, std::memory_order_release);
+        }
+
+        return function;
+    }
+}
+
+// Calls the real function; expects a Function alias for its pointer type in scope
+#define VIATOR_FORWARD_TO_NEXT_VERSION(name, version, args) \
+    static std::atomic<void*> next { nullptr }; \
+    return reinterpret_cast<Function> (nextSymbol (#name, version, next)) args;
+
+#define VIATOR_FORWARD_TO_NEXT(name, args) VIATOR_FORWARD_TO_NEXT_VERSION (name, nullptr, args)
+
+// glibc keeps the pre-2.3.2 condition variables under the same names, and those
+// would misread a pthread_cond_t the current ones initialised
+#define VIATOR_CONDITION_VERSION "GLIBC_2.3.2"
+
+//==============================================================================
+extern "C"
+{
+    void* malloc (size_t size) __THROW                  { reportViolation ("malloc");  return __libc_malloc (size); }
+    void* calloc (size_t count, size_t size) __THROW    { reportViolation ("calloc");  return __libc_calloc (count, size); }
+    void* realloc (void* ptr, size_t size) __THROW      { reportViolation ("realloc"); return __libc_realloc (ptr, size); }
+
+    void free (void* ptr) __THROW
+    {
+        if (ptr != nullptr)
+            reportViolation ("free");
+
+        __libc_free (ptr);
+    }
+
+    // Over-aligned operator new comes through these rather than malloc
+    void* memalign (size_t alignment, size_t size) __THROW       { reportViolation ("memalign");      return __libc_memalign (alignment, size); }
+    void* aligned_alloc (size_t alignment, size_t size) __THROW  { reportViolation ("aligned_alloc"); return __libc_memalign (alignment, size); }
+
+    int posix_memalign (void** result, size_t alignment, size_t size) __THROW
+    {
+        reportViolation ("posix_memalign");
+
+        if (alignment % sizeof (void*) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0)
+            return EINVAL;
+
+        auto* ptr = __libc_memalign (alignment, size);
+
+        if (ptr == nullptr)
+            return ENOMEM;
+
+        *result = ptr;
+        return 0;
+    }
+
+    int pthread_mutex_lock (pthread_mutex_t* mutex) __THROWNL
+    {
+        reportViolation ("pthread_mutex_lock");
+        using Function = int (*) (pthread_mutex_t*);
+        VIATOR_FORWARD_TO_NEXT (pthread_mutex_lock, (mutex))
+    }
+
+    int pthread_cond_wait (pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        reportViolation ("pthread_cond_wait");
+        using Function = int (*) (pthread_cond_t*, pthread_mutex_t*);
+        VIATOR_FORWARD_TO_NEXT_VERSION (pthread_cond_wait, VIATOR_CONDITION_VERSION, (condition, mutex))
+    }
+
+    int pthread_cond_timedwait (pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* time)
+    {
+        reportViolation ("pthread_cond_timedwait");
+        using Function = int (*) (pthread_cond_t*, pthread_mutex_t*, const struct timespec*);
+        VIATOR_FORWARD_TO_NEXT_VERSION (pthread_cond_timedwait, VIATOR_CONDITION_VERSION, (condition, mutex, time))
+    }
+
+    int pthread_join (pthread_t thread, void** result)
+    {
+        reportViolation ("pthread_join");
+        using Function = int (*) (pthread_t, void**);
+        VIATOR_FORWARD_TO_NEXT (pthread_join, (thread, result))
+    }
+
+    int sem_wait (sem_t* semaphore)
+    {
+        reportViolation ("sem_wait");
+        using Function = int (*) (sem_t*);
+        VIATOR_FORWARD_TO_NEXT (sem_wait, (semaphore))
+    }
+
+    int nanosleep (const struct timespec* duration, struct timespec* remaining)
+    {
+        reportViolation ("nanosleep");
+        using Function = int (*) (const struct timespec*, struct timespec*);
+        VIATOR_FORWARD_TO_NEXT (nanosleep, (duration, remaining))
+    }
+
+    int usleep (useconds_t microseconds)
+    {
+        reportViolation ("usleep");
+        using Function = int (*) (useconds_t);
+        VIATOR_FORWARD_TO_NEXT (usleep, (microseconds))
+    }
+
+    int poll (struct pollfd* fds, nfds_t numFds, int timeout)
+    {
+        reportViolation ("poll");
+        using Function = int (*) (struct pollfd*, nfds_t, int);
+        VIATOR_FORWARD_TO_NEXT (poll, (fds, numFds, timeout))
+    }
+
+    ssize_t read (int fd, void* buffer, size_t size)
+    {
+        reportViolation ("read");
+        using Function = ssize_t (*) (int, void*, size_t);
+        VIATOR_FORWARD_TO_NEXT (read, (fd, buffer, size))
+    }
+
+    ssize_t write (int fd, const void* buffer, size_t size)
+    {
+        reportViolation ("write");
+        using Function = ssize_t (*) (int, const void*, size_t);
+        VIATOR_FORWARD_TO_NEXT (write, (fd, buffer, size))
+    }
+}
+
+#undef VIATOR_CONDITION_VERSION
+#undef VIATOR_FORWARD_TO_NEXT
+#undef VIATOR_FORWARD_TO_NEXT_VERSION
+
+bool RealtimeChecker::isAvailable() noexcept                        { return true; }
+void RealtimeChecker::setTrapOnViolation (bool shouldTrap) noexcept  { trapOnViolation = shouldTrap; }
+int RealtimeChecker::getNumViolations() noexcept                    { return numViolations; }
+void RealtimeChecker::resetViolations() noexcept                    { numViolations = 0; }
+
+#else
+
+bool RealtimeChecker::isAvailable() noexcept                        { return false; }
+void RealtimeChecker::setTrapOnViolation (bool) noexcept            {}
+int RealtimeChecker::getNumViolations() noexcept                    { return 0; }
+void RealtimeChecker::resetViolations() noexcept                    {}
+
+#endif
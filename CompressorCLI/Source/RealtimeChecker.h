@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+    RealtimeChecker.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Reports allocation, mutex locks and blocking calls made on a thread while a
+    RealtimeScope is active, with a stack trace of each of the first few.
+
+    The hooks replace the libc symbols for the whole executable, so they're only
+    compiled into builds with VIATOR_REALTIME_CHECKS=1 (the CLI's Debug
+    configuration) on Linux/glibc; elsewhere isAvailable() returns false.
+*/
+struct RealtimeChecker
+{
+    static bool isAvailable() noexcept;
+
+    /** Aborts on the first violation instead of logging it, so a debugger stops there. */
+    static void setTrapOnViolation (bool shouldTrap) noexcept;
+
+    static int getNumViolations() noexcept;
+    static void resetViolations() noexcept;
+};
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    StateBenchmark.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StateBenchmark.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+    using Processors = std::vector<std::unique_ptr<CompressorPrototyperAudioProcessor>>;
+
+    /** A different random session for each instance, saved in both formats. */
+    void makeStates (Processors& processors, std::vector<juce::MemoryBlock>& compactStates,
+                     std::vector<juce::MemoryBlock>& valueTreeStates, juce::Random& random)
+    {
+        for (auto& processor : processors)
+        {
+            for (auto* parameter : processor->getParameters())
+                parameter->setValueNotifyingHost (random.nextFloat());
+
+            compactStates.emplace_back();
+            processor->getStateInformation (compactStates.back());
+
+            // What getStateInformation() wrote before the compact format
+            valueTreeStates.emplace_back();
+            juce::MemoryOutputStream stream (valueTreeStates.back(), false);
+            processor->treeState.copyState().writeToStream (stream);
+        }
+    }
+
+    /** Milliseconds for restoreOne over every instance, best of a few passes. */
+    template <typename RestoreFunction>
+    double timeRestore (Processors& processors, int numPasses, RestoreFunction&& restoreOne)
+    {
+        auto best = std::numeric_limits<double>::max();
+
+        for (auto pass = 0; pass < numPasses; ++pass)
+        {
+            auto start = juce::Time::getMillisecondCounterHiRes();
+
+            for (size_t i = 0; i < processors.size(); ++i)
+                restoreOne (*processors[i], i);
+
+            best = juce::jmin (best, juce::Time::getMillisecondCounterHiRes() - start);
+        }
+
+        return best;
+    }
+
+    /** Fills a scratch folder with presets, then times opening an instance on it and
+        how long the library takes to finish loading behind it.
+    */
+    void timeUserLibrary (int numPresets)
+    {
+        auto directory = juce::File::createTempFile ("presets");
+        juce::Random random;
+
+        {
+            CompressorPrototyperAudioProcessor writer;
+            writer.setUserPresetDirectory (directory);
+
+            for (auto i = 0; i < numPresets; ++i)
+            {
+                for (auto* parameter : writer.getParameters())
+                    parameter->setValueNotifyingHost (random.nextFloat());
+
+                writer.saveUserPreset ("User " + juce::String (i).paddedLeft ('0', 5));
+            }
+        }
+
+        auto start = juce::Time::getMillisecondCounterHiRes();
+        CompressorPrototyperAudioProcessor processor;
+        processor.setUserPresetDirectory (directory);
+        auto numProgramsAtOpen = processor.getNumPrograms();
+        auto openTime = juce::Time::getMillisecondCounterHiRes() - start;
+
+        while (processor.isLoadingUserPresets())
+            juce::Thread::sleep (1);
+
+        auto loadTime = juce::Time::getMillisecondCounterHiRes() - start;
+
+        std::cout << std::endl << "User library of " << numPresets << " presets: open and getNumPrograms() "
+                  << juce::String (openTime, 2) << " ms (" << numProgramsAtOpen << " programs), all "
+                  << processor.getNumPrograms() << " programs after " << juce::String (loadTime, 2) << " ms in the background" << std::endl;
+
+        directory.deleteRecursively();
+    }
+
+    void printRow (const juce::String& name, double milliseconds, size_t numInstances, size_t bytesPerState)
+    {
+        std::cout << name.paddedRight (' ', 26)
+                  << juce::String (milliseconds, 2).paddedLeft (' ', 10)
+                  << juce::String (milliseconds * 1000.0 / (double) numInstances, 2).paddedLeft (' ', 14)
+                  << (bytesPerState > 0 ? juce::String ((int) bytesPerState) : juce::String ("-")).paddedLeft (' ', 12) << std::endl;
+    }
+}
+
+//==============================================================================
+int runStateBenchmark (const CommandLine& commandLine)
+{
+    const auto numInstances = (size_t) juce::jmax (1, commandLine.getInt ("instances", 500));
+    const auto numPasses = juce::jmax (1, commandLine.getInt ("passes", 5));
+
+    // Set up like a session being recalled: every instance prepared, none playing
+    Processors processors;
+
+    for (size_t i = 0; i < numInstances; ++i)
+    {
+        processors.push_back (std::make_unique<CompressorPrototyperAudioProcessor>());
+        prepareProcessor (*processors.back(), 2, 48000.0, 512);
+    }
+
+    juce::Random random (commandLine.getInt ("seed", 1));
+    std::vector<juce::MemoryBlock> compactStates, valueTreeStates;
+    makeStates (processors, compactStates, valueTreeStates, random);
+
+    auto restoreFrom = [] (const std::vector<juce::MemoryBlock>& states)
+    {
+        return [&states] (CompressorPrototyperAudioProcessor& processor, size_t i)
+        {
+            processor.setStateInformation (states[i].getData(), (int) states[i].getSize());
+        };
+    };
+
+    std::cout << "Restoring " << numInstances << " instances, best of " << numPasses << " passes" << std::endl
+              << "state                        total ms   us/instance  bytes/state" << std::endl;
+
+    printRow ("compact", timeRestore (processors, numPasses, restoreFrom (compactStates)),
+              numInstances, compactStates.front().getSize());
+
+    printRow ("ValueTree via fallback", timeRestore (processors, numPasses, restoreFrom (valueTreeStates)),
+              numInstances, valueTreeStates.front().getSize());
+
+    // The restore this replaced: parse, then hand the whole tree to the APVTS
+    printRow ("ValueTree, previous", timeRestore (processors, numPasses, [&] (CompressorPrototyperAudioProcessor& processor, size_t i)
+              {
+                  auto tree = juce::ValueTree::readFromData (valueTreeStates[i].getData(), valueTreeStates[i].getSize());
+
+                  if (tree.isValid())
+                      processor.treeState.state = tree;
+              }), numInstances, valueTreeStates.front().getSize());
+
+    juce::MemoryBlock savedState;
+    printRow ("save (compact)", timeRestore (processors, numPasses, [&] (CompressorPrototyperAudioProcessor& processor, size_t)
+              {
+                  processor.getStateInformation (savedState);
+              }), numInstances, 0);
+
+    for (auto& processor : processors)
+    {
+        processor->storeSnapshot (0);
+        processor->setStateInformation (compactStates.front().getData(), (int) compactStates.front().getSize());
+        processor->storeSnapshot (1);
+    }
+
+    auto slot = 0;
+    printRow ("A/B recall", timeRestore (processors, numPasses, [&] (CompressorPrototyperAudioProcessor& processor, size_t)
+              {
+                  processor.recallSnapshot (slot);
+                  slot = 1 - slot;
+              }), numInstances, 0);
+
+    // From the message thread a program change is applied to the parameters straight away;
+    // from the audio thread it's only the two stores
+    auto program = 0;
+    printRow ("program change", timeRestore (processors, numPasses, [&] (CompressorPrototyperAudioProcessor& processor, size_t)
+              {
+                  program = (program + 1) % 8;
+                  processor.setCurrentProgram (program);
+              }), numInstances, 0);
+
+    for (auto& processor : processors)
+        processor->releaseResources();
+
+    processors.clear();
+    timeUserLibrary (commandLine.getInt ("presets", 2000));
+    return 0;
+}
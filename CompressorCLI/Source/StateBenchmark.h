@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    StateBenchmark.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CommandLine.h"
+
+//==============================================================================
+/** Restores a saved state into every instance of a session-sized set of
+    processors (500 by default, --instances=N) and prints the time for the compact
+    format, the old ValueTree blobs through the fallback reader, and the previous
+    ValueTree restore, plus the state size and the cost of an A/B recall and a
+    program change. Then times opening an instance on a user preset library
+    (--presets=N, 2000 by default) against loading all of it in the background.
+*/
+int runStateBenchmark (const CommandLine& commandLine);
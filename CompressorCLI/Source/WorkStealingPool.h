@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    WorkStealingPool.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Runs a batch of indexed tasks across a fixed set of threads, the caller
+    included, the way a host spreads one audio callback's plug-ins over its cores.
+
+    Each run hands every thread a contiguous range of task indices, so a task tends
+    to land on the same core every callback. A thread takes tasks from the back of
+    its own range and, once that's empty, steals from the front of the others'.
+    Each range is one 64-bit word changed by compare-and-swap, so taking a task
+    never locks or allocates. Between runs the workers sleep on an event.
+*/
+class WorkStealingPool
+{
+public:
+    /** numThreads counts the thread that calls run(), so 1 runs everything inline. */
+    explicit WorkStealingPool (int numThreads)
+        : queues ((size_t) juce::jmax (1, numThreads))
+    {
+        for (auto i = 1; i < (int) queues.size(); ++i)
+        {
+            workers.add (new Worker (*this, i));
+            workers.getLast()->startThread (9);
+        }
+    }
+
+    ~WorkStealingPool()
+    {
+        for (auto* worker : workers)
+        {
+            worker->signalThreadShouldExit();
+            worker->wakeUp.signal();
+        }
+
+        for (auto* worker : workers)
+            worker->stopThread (1000);
+    }
+
+    int getNumThreads() const noexcept      { return (int) queues.size(); }
+
+    /** Tasks taken from another thread's range during the last run. */
+    int getNumSteals() const noexcept       { return numSteals.load(); }
+
+    /** Calls task (index) once for every index below numTasks and returns when all have
+        finished. A task may finish others' work, e.g. the last channel into a bus
+        running the bus, but mustn't call run() itself.
+    */
+    template <typename Task>
+    void run (int numTasks, Task& task)
+    {
+        context = &task;
+        invoke = [] (void* taskToRun, int index) { (*static_cast<Task*> (taskToRun)) (index); };
+        remaining.store (numTasks, std::memory_order_relaxed);
+        numSteals.store (0, std::memory_order_relaxed);
+
+        // Publishes the task above along with the ranges
+        const auto numQueues = (juce::uint64) queues.size();
+
+        for (juce::uint64 queue = 0; queue < numQueues; ++queue)
+            queues[(size_t) queue].range.store (pack ((juce::uint32) ((juce::uint64) numTasks * queue / numQueues),
+                                                      (juce::uint32) ((juce::uint64) numTasks * (queue + 1) / numQueues)),
+                                                std::memory_order_release);
+
+        for (auto* worker : workers)
+            worker->wakeUp.signal();
+
+        work (0);
+
+        // Whatever is left is already running on another thread
+        while (remaining.load (std::memory_order_acquire) > 0)
+            std::this_thread::yield();
+    }
+
+private:
+    // The indices [front, back) still to run, with back in the high half
+    static juce::uint64 pack (juce::uint32 front, juce::uint32 back) noexcept   { return ((juce::uint64) back << 32) | front; }
+    static juce::uint32 getFront (juce::uint64 range) noexcept                  { return (juce::uint32) range; }
+    static juce::uint32 getBack (juce::uint64 range) noexcept                   { return (juce::uint32) (range >> 32); }
+
+    struct alignas (64) Queue   // one per cache line, so threads don't contend on their neighbours' ranges
+    {
+        std::atomic<juce::uint64> range { 0 };
+    };
+
+    bool take (Queue& queue, bool fromBack, int& index) noexcept
+    {
+        auto range = queue.range.load (std::memory_order_acquire);
+
+        for (;;)
+        {
+            auto front = getFront (range), back = getBack (range);
+
+            if (front >= back)
+                return false;
+
+            auto remainder = fromBack ? pack (front, back - 1) : pack (front + 1, back);
+
+            if (queue.range.compare_exchange_weak (range, remainder, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                index = (int) (fromBack ? back - 1 : front);
+                return true;
+            }
+        }
+    }
+
+    void work (int self) noexcept
+    {
+        const auto numQueues = (int) queues.size();
+
+        for (;;)
+        {
+            auto index = 0;
+            auto found = take (queues[(size_t) self], true, index);
+
+            for (auto offset = 1; ! found && offset < numQueues; ++offset)
+                if ((found = take (queues[(size_t) ((self + offset) % numQueues)], false, index)))
+                    numSteals.fetch_add (1, std::memory_order_relaxed);
+
+            if (! found)
+                return;
+
+            invoke (context, index);
+            remaining.fetch_sub (1, std::memory_order_acq_rel);
+        }
+    }
+
+    //==============================================================================
+    class Worker  : public juce::Thread
+    {
+    public:
+        Worker (WorkStealingPool& poolToJoin, int indexInPool)
+            : juce::Thread ("Mixer worker " + juce::String (indexInPool)), pool (poolToJoin), index (indexInPool)
+        {
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wakeUp.wait (-1);
+
+                if (! threadShouldExit())
+                    pool.work (index);
+            }
+        }
+
+        juce::WaitableEvent wakeUp;
+
+    private:
+        WorkStealingPool& pool;
+        int index;
+    };
+
+    std::vector<Queue> queues;
+    juce::OwnedArray<Worker> workers;
+
+    void* context = nullptr;
+    void (*invoke) (void*, int) = nullptr;
+    std::atomic<int> remaining { 0 }, numSteals { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (WorkStealingPool)
+};
@@ -0,0 +1,432 @@
+/*
+  ==============================================================================
+
+    BatchCompressor.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ViatorCompressor.h"
+
+//==============================================================================
+/**
+    Many independent mono compressors run together, for a host that owns its mixer
+    and has dozens of channels sharing one block size. Each compressor is one SIMD
+    lane. Its settings, ramps and envelope live in struct-of-arrays form, one vector
+    per numLanes compressors, so a single pass advances numLanes envelopes with
+    different attack, release, threshold and ratio.
+
+    The ballistics, gain law, ramps and gain tiers are ViatorCompressor's peak
+    detector with the per-channel mode and no lookahead. A compressor here gives
+    the same output as a mono ViatorCompressor (or processor instance) with the
+    same settings, to float rounding.
+
+    process() takes one buffer per compressor and gathers each group of lanes from
+    them. processInterleaved() takes frames with the compressors side by side, so
+    each group's lanes are read straight from contiguous memory.
+*/
+template <typename SampleType>
+class BatchCompressor
+{
+public:
+    using Vector = juce::dsp::SIMDRegister<SampleType>;
+    using GainMath = typename ViatorCompressor<SampleType>::GainMath;
+    static constexpr size_t numLanes = Vector::size();
+
+    /** Compressors added start at ViatorCompressor's defaults: 0 dB threshold, ratio 1,
+        1 ms attack, 100 ms release and unity gains. Allocates; call before prepare().
+    */
+    void setNumCompressors (size_t newNumCompressors)
+    {
+        const auto oldNumCompressors = numCompressors;
+        numCompressors = newNumCompressors;
+        numGroups = (numCompressors + numLanes - 1) / numLanes;
+
+        for (auto* values : { &attackCoefficients, &releaseCoefficients, &exponents, &thresholdInverses, &envelopes })
+            values->resize (numGroups);
+
+        for (auto* ramp : { &thresholdDecibels, &inputGain, &outputGain })
+            ramp->resize (numGroups);
+
+        attackTimes.resize (numGroups * numLanes);
+        releaseTimes.resize (numGroups * numLanes);
+
+        // Padding lanes get the defaults too, so they stay silent and cheap
+        for (auto index = juce::jmin (oldNumCompressors, numCompressors); index < numGroups * numLanes; ++index)
+        {
+            thresholdDecibels.setCurrentAndTargetValue (index, 0);
+            updateThresholdInverse (index);
+            inputGain.setCurrentAndTargetValue (index, 1);
+            outputGain.setCurrentAndTargetValue (index, 1);
+            getLane (exponents, index) = 0;
+            getLane (envelopes, index) = 0;
+            attackTimes[index] = 1;
+            releaseTimes[index] = 100;
+            updateCoefficients (index);
+        }
+    }
+
+    size_t getNumCompressors() const noexcept       { return numCompressors; }
+
+    //==============================================================================
+    void setThreshold (size_t index, SampleType newThresholdDecibels) noexcept
+    {
+        jassert (index < numCompressors);
+        thresholdDecibels.setTargetValue (index, newThresholdDecibels, numRampSteps);
+        updateThresholdInverse (index);
+    }
+
+    void setRatio (size_t index, SampleType newRatio) noexcept
+    {
+        jassert (index < numCompressors && newRatio >= 1);
+        getLane (exponents, index) = SampleType (1) / newRatio - SampleType (1);
+    }
+
+    void setAttack (size_t index, SampleType newAttackMs) noexcept
+    {
+        jassert (index < numCompressors);
+        attackTimes[index] = newAttackMs;
+        updateCoefficients (index);
+    }
+
+    void setRelease (size_t index, SampleType newReleaseMs) noexcept
+    {
+        jassert (index < numCompressors);
+        releaseTimes[index] = newReleaseMs;
+        updateCoefficients (index);
+    }
+
+    void setInputGainDecibels (size_t index, SampleType newGainDecibels) noexcept
+    {
+        jassert (index < numCompressors);
+        inputGain.setTargetValue (index, juce::Decibels::decibelsToGain (newGainDecibels), numRampSteps);
+    }
+
+    void setOutputGainDecibels (size_t index, SampleType newGainDecibels) noexcept
+    {
+        jassert (index < numCompressors);
+        outputGain.setTargetValue (index, juce::Decibels::decibelsToGain (newGainDecibels), numRampSteps);
+    }
+
+    /** One tier for every compressor in the batch. */
+    void setGainMath (GainMath newTier) noexcept                    { gainMath = newTier; }
+
+    void setRampDurationSeconds (double newDurationSeconds) noexcept
+    {
+        rampDurationSeconds = newDurationSeconds;
+        updateRampSteps();
+    }
+
+    //==============================================================================
+    void prepare (double newSampleRate, size_t maximumBlockSize)
+    {
+        jassert (newSampleRate > 0);
+
+        sampleRate = newSampleRate;
+        audio.resize (maximumBlockSize);
+        gains.resize (maximumBlockSize);
+        inputGains.resize (maximumBlockSize);
+        outputGains.resize (maximumBlockSize);
+        blockThresholdInverses.resize (maximumBlockSize);
+
+        for (size_t index = 0; index < numGroups * numLanes; ++index)
+            updateCoefficients (index);
+
+        updateRampSteps();
+        reset();
+    }
+
+    /** Frees the block buffers prepare() allocated, keeping the settings. */
+    void releaseResources()
+    {
+        for (auto* buffer : { &audio, &gains, &inputGains, &outputGains, &blockThresholdInverses })
+            std::vector<Vector>().swap (*buffer);
+    }
+
+    void reset() noexcept
+    {
+        std::fill (envelopes.begin(), envelopes.end(), Vector::expand (0));
+
+        for (auto* ramp : { &thresholdDecibels, &inputGain, &outputGain })
+            ramp->finish();
+    }
+
+    //==============================================================================
+    /** channels[i] is compressor i's signal, processed in place. */
+    void process (SampleType* const* channels, size_t numSamples) noexcept
+    {
+        jassert (numSamples <= audio.size());
+
+        auto* raw = reinterpret_cast<SampleType*> (audio.data());
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            const auto firstIndex = group * numLanes;
+            const auto numActive = juce::jmin (numLanes, numCompressors - firstIndex);
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                if (lane < numActive)
+                {
+                    const auto* source = channels[firstIndex + lane];
+
+                    for (size_t i = 0; i < numSamples; ++i)
+                        raw[i * numLanes + lane] = source[i];
+                }
+                else
+                {
+                    for (size_t i = 0; i < numSamples; ++i)
+                        raw[i * numLanes + lane] = 0;
+                }
+            }
+
+            processGroup (group, numSamples);
+
+            for (size_t lane = 0; lane < numActive; ++lane)
+            {
+                auto* destination = channels[firstIndex + lane];
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    destination[i] = raw[i * numLanes + lane];
+            }
+        }
+    }
+
+    /** frames holds numSamples frames of getNumCompressors() samples, compressor i's
+        sample at frames[frame * getNumCompressors() + i], processed in place.
+    */
+    void processInterleaved (SampleType* frames, size_t numSamples) noexcept
+    {
+        jassert (numSamples <= audio.size());
+
+        auto* raw = reinterpret_cast<SampleType*> (audio.data());
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            const auto firstIndex = group * numLanes;
+            const auto numActive = juce::jmin (numLanes, numCompressors - firstIndex);
+
+            if (numActive < numLanes)
+                std::fill (raw, raw + numSamples * numLanes, SampleType (0));
+
+            for (size_t i = 0; i < numSamples; ++i)
+                std::copy_n (frames + i * numCompressors + firstIndex, numActive, raw + i * numLanes);
+
+            processGroup (group, numSamples);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                std::copy_n (raw + i * numLanes, numActive, frames + i * numCompressors + firstIndex);
+        }
+    }
+
+private:
+    //==============================================================================
+    /** A SmoothedValue per lane, with the same linear steps, advanced a vector at a time. */
+    struct Ramp
+    {
+        std::vector<Vector> current, target, step, remaining;
+
+        void resize (size_t numGroups)
+        {
+            for (auto* values : { &current, &target, &step, &remaining })
+                values->resize (numGroups);
+        }
+
+        void setCurrentAndTargetValue (size_t index, SampleType value) noexcept
+        {
+            getLane (current, index) = getLane (target, index) = value;
+            getLane (remaining, index) = 0;
+        }
+
+        void setTargetValue (size_t index, SampleType value, int numSteps) noexcept
+        {
+            if (value == getLane (target, index))
+                return;
+
+            if (numSteps <= 0)
+            {
+                setCurrentAndTargetValue (index, value);
+                return;
+            }
+
+            getLane (target, index) = value;
+            getLane (remaining, index) = (SampleType) numSteps;
+            getLane (step, index) = (value - getLane (current, index)) / (SampleType) numSteps;
+        }
+
+        void finish() noexcept
+        {
+            current = target;
+            std::fill (remaining.begin(), remaining.end(), Vector::expand (0));
+        }
+
+        bool isSmoothing (size_t group) const noexcept
+        {
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                if (getLane (remaining, group * numLanes + lane) > 0)
+                    return true;
+
+            return false;
+        }
+
+        // One value per sample, as SmoothedValue::getNextValue() would give each lane
+        void fill (size_t group, Vector* values, size_t numSamples) noexcept
+        {
+            if (! isSmoothing (group))
+            {
+                std::fill (values, values + numSamples, current[group]);
+                return;
+            }
+
+            const auto one = Vector::expand (1), zero = Vector::expand (0);
+            auto value = current[group], left = remaining[group];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                left = Vector::max (left - one, zero);
+                const auto stepping = Vector::greaterThan (left, zero);
+                value = ((value + step[group]) & stepping) + (target[group] & ~stepping);
+                values[i] = value;
+            }
+
+            current[group] = value;
+            remaining[group] = left;
+        }
+    };
+
+    template <typename Values>
+    static auto& getLane (Values& values, size_t index) noexcept
+    {
+        using Lane = typename std::conditional<std::is_const<Values>::value, const SampleType, SampleType>::type;
+        return reinterpret_cast<Lane*> (values.data())[index];
+    }
+
+    // Same one-pole time constant as ViatorCompressor and juce::dsp::BallisticsFilter
+    SampleType calculateCoefficient (SampleType timeMs) const noexcept
+    {
+        return timeMs < static_cast<SampleType> (1.0e-3) ? 0
+                                                         : static_cast<SampleType> (std::exp (-2.0 * juce::MathConstants<double>::pi * 1000.0
+                                                                                             / (sampleRate * (double) timeMs)));
+    }
+
+    void updateCoefficients (size_t index) noexcept
+    {
+        if (sampleRate <= 0)
+            return;
+
+        getLane (attackCoefficients, index) = calculateCoefficient (attackTimes[index]);
+        getLane (releaseCoefficients, index) = calculateCoefficient (releaseTimes[index]);
+    }
+
+    // Where the threshold settles, for blocks in which it isn't ramping
+    void updateThresholdInverse (size_t index) noexcept
+    {
+        getLane (thresholdInverses, index) = SampleType (1) / juce::Decibels::decibelsToGain (getLane (thresholdDecibels.target, index), SampleType (-200));
+    }
+
+    void updateRampSteps() noexcept
+    {
+        numRampSteps = sampleRate > 0 ? (int) std::floor (rampDurationSeconds * sampleRate) : 0;
+    }
+
+    // The threshold ramps in decibels, so a ramping group converts every lane every sample
+    void fillThresholdInverses (size_t group, size_t numSamples) noexcept
+    {
+        if (! thresholdDecibels.isSmoothing (group))
+        {
+            std::fill (blockThresholdInverses.begin(), blockThresholdInverses.begin() + (std::ptrdiff_t) numSamples, thresholdInverses[group]);
+            return;
+        }
+
+        thresholdDecibels.fill (group, blockThresholdInverses.data(), numSamples);
+        auto* values = reinterpret_cast<SampleType*> (blockThresholdInverses.data());
+
+        if (gainMath == GainMath::fast)
+        {
+            for (size_t i = 0; i < numSamples * numLanes; ++i)
+                values[i] = FastGainMath<SampleType>::inverseDecibelsToGain (values[i]);
+
+            return;
+        }
+
+        for (size_t i = 0; i < numSamples * numLanes; ++i)
+            values[i] = SampleType (1) / juce::Decibels::decibelsToGain (values[i], SampleType (-200));
+    }
+
+    // Input gain, ballistics, gain computer and gain for numLanes compressors over the block in audio
+    void processGroup (size_t group, size_t numSamples) noexcept
+    {
+        inputGain.fill (group, inputGains.data(), numSamples);
+        outputGain.fill (group, outputGains.data(), numSamples);
+        fillThresholdInverses (group, numSamples);
+
+        const auto release = releaseCoefficients[group];
+        const auto attackMinusRelease = attackCoefficients[group] - release;
+        auto envelope = envelopes[group];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            audio[i] = audio[i] * inputGains[i];
+            const auto level = Vector::abs (audio[i]);
+            const auto coefficient = release + (attackMinusRelease & Vector::greaterThan (level, envelope));
+            envelope = level + coefficient * (envelope - level);
+            gains[i] = envelope;
+        }
+
+        envelopes[group] = envelope;
+
+        if (gainMath == GainMath::fast)
+            computeGains<GainMath::fast> (group, numSamples);
+        else
+            computeGains<GainMath::exact> (group, numSamples);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            audio[i] = audio[i] * gains[i];
+    }
+
+    // Envelopes to gains in place, each lane with its own threshold, exponent and trim.
+    // The fast tier has no branches or calls in the lane loop, so it vectorises.
+    template <GainMath tier>
+    void computeGains (size_t group, size_t numSamples) noexcept
+    {
+        auto* values = reinterpret_cast<SampleType*> (gains.data());
+        const auto* inverses = reinterpret_cast<const SampleType*> (blockThresholdInverses.data());
+        const auto* trims = reinterpret_cast<const SampleType*> (outputGains.data());
+        const auto* laneExponents = reinterpret_cast<const SampleType*> (exponents.data() + group);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                const auto k = i * numLanes + lane;
+                values[k] = computeGain<tier> (values[k] * inverses[k], laneExponents[lane]) * trims[k];
+            }
+        }
+    }
+
+    template <GainMath tier>
+    static SampleType computeGain (SampleType overshoot, SampleType exponent) noexcept
+    {
+        if constexpr (tier == GainMath::fast)
+            return FastGainMath<SampleType>::computeGain (overshoot, exponent);
+        else
+            return overshoot < SampleType (1) ? SampleType (1) : std::pow (overshoot, exponent);
+    }
+
+    //==============================================================================
+    // One vector per group of numLanes compressors
+    std::vector<Vector> attackCoefficients, releaseCoefficients, exponents, thresholdInverses, envelopes;
+    Ramp thresholdDecibels, inputGain, outputGain;
+    std::vector<SampleType> attackTimes, releaseTimes;
+
+    // One vector per sample, reused by every group
+    std::vector<Vector> audio, gains, inputGains, outputGains, blockThresholdInverses;
+
+    size_t numCompressors = 0, numGroups = 0;
+    GainMath gainMath = GainMath::exact;
+    double sampleRate = 0.0, rampDurationSeconds = 0.02;
+    int numRampSteps = 0;
+};
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    FastGainMath.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Bounded-error log2 / exp2 for the gain computer, built only from multiplies,
+    adds and bit manipulation so loops over them auto-vectorise (no calls into
+    libm, no branches): float with SSE2 or NEON, double from AVX2 up.
+
+    log2 splits off the exponent bits and fits log2 (1 + t) on the mantissa with
+    t * P (t); exp2 splits x into whole and fractional parts, builds 2^whole in the
+    exponent bits and fits 2^f with 1 + f * Q (f). Both P and Q are degree 4,
+    interpolated at Chebyshev nodes, which keeps the absolute log2 error under
+    5.1e-5 and the relative exp2 error under 2.2e-7. Both are exact at their
+    anchor points, log2 (1) == 0 and exp2 (0) == 1.
+
+    Through the gain law (x / threshold) ^ (1 / ratio - 1) that puts the gain
+    within maximumErrorDecibels of the exact value for any ratio from 1 to 10 and
+    any overshoot the detector can produce. Double uses the same polynomials, so
+    it has the same bound; it is there for the double-precision engine, not for
+    extra accuracy.
+*/
+template <typename SampleType>
+struct FastGainMath
+{
+    static_assert (std::is_floating_point<SampleType>::value, "FastGainMath needs float or double");
+
+    /** Stated worst case, with margin over the measured ~0.0003 dB. */
+    static constexpr double maximumErrorDecibels = 0.001;
+
+    /** log2 of a positive, normal x; 0 and denormals come out as about -127 (float) or -1023 (double). */
+    static SampleType log2 (SampleType x) noexcept
+    {
+        Integer bits;
+        std::memcpy (&bits, &x, sizeof (x));
+
+        const auto exponent = (SampleType) (juce::int32) ((bits >> mantissaBits) - exponentBias);
+        bits = (bits & mantissaMask) | ((Integer) exponentBias << mantissaBits);
+
+        SampleType mantissa;
+        std::memcpy (&mantissa, &bits, sizeof (mantissa));
+
+        const auto t = mantissa - SampleType (1);
+        return exponent + t * (SampleType (1.44260389) + t * (SampleType (-0.716714663) + t * (SampleType (0.440599033)
+                                + t * (SampleType (-0.225103025) + t * SampleType (0.0586649397)))));
+    }
+
+    /** 2^x for |x| < 2^31, flushed to the smallest normal below it and saturated above it. */
+    static SampleType exp2 (SampleType x) noexcept
+    {
+        // Floor without a libm call: truncate, then step down for negative fractions.
+        // The whole part is clamped as an integer; clamping x first stops GCC vectorising.
+        auto whole = (juce::int32) x;
+        whole -= (juce::int32) (x < (SampleType) whole);
+        const auto f = x - (SampleType) whole;
+        whole = std::min (std::max (whole, 1 - exponentBias), exponentBias);
+
+        const auto bits = (Integer) (whole + exponentBias) << mantissaBits;
+        SampleType scale;
+        std::memcpy (&scale, &bits, sizeof (scale));
+
+        return scale * (SampleType (1) + f * (SampleType (0.693147568) + f * (SampleType (0.240207194) + f * (SampleType (0.0556570544)
+                                              + f * (SampleType (0.0091993876) + f * SampleType (0.00178836874))))));
+    }
+
+    /** The compressor's gain law for exponent = 1 / ratio - 1 <= 0: 1 below threshold,
+        overshoot ^ exponent above it. Below threshold the power comes out above 1, so a
+        min() does the job of the branch and the loop still vectorises. log2 (0) is
+        just a large negative number here, not -inf.
+    */
+    static SampleType computeGain (SampleType overshoot, SampleType exponent) noexcept
+    {
+        return std::min (exp2 (exponent * log2 (overshoot)), SampleType (1));
+    }
+
+    /** 1 / decibelsToGain (thresholdDecibels), as one exp2. */
+    static SampleType inverseDecibelsToGain (SampleType thresholdDecibels) noexcept
+    {
+        return exp2 (thresholdDecibels * SampleType (-0.166096404744368)); // -log2 (10) / 20
+    }
+
+private:
+    using Integer = typename std::conditional<sizeof (SampleType) == sizeof (juce::int32), juce::int32, juce::int64>::type;
+
+    static constexpr int mantissaBits = std::numeric_limits<SampleType>::digits - 1;
+    static constexpr int exponentBias = std::numeric_limits<SampleType>::max_exponent - 1;
+    static constexpr Integer mantissaMask = ((Integer) 1 << mantissaBits) - 1;
+};
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    LevelMeter.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** One block's worth of metering, published by the audio thread. */
+struct MeterFrame
+{
+    float peakIn = 0.0f;
+    float peakOut = 0.0f;
+    float gainReductionDecibels = 0.0f;   // <= 0
+};
+
+//==============================================================================
+/**
+    Wait-free single-producer/single-consumer queue of MeterFrames.
+
+    The audio thread pushes one frame per block and never blocks or allocates; if
+    the editor has fallen behind, the frame is simply dropped. The editor pulls
+    everything published since its last timer tick and keeps the worst case.
+*/
+class MeterFifo
+{
+public:
+    void push (const MeterFrame& frame) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (1, start1, size1, start2, size2);
+
+        if (size1 > 0)
+            frames[(size_t) start1] = frame;
+
+        fifo.finishedWrite (size1);
+    }
+
+    /** Combines every pending frame into one; returns false if nothing was published. */
+    bool pull (MeterFrame& result) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+            return false;
+
+        result = {};
+
+        auto combine = [this, &result] (int start, int size)
+        {
+            for (auto i = start; i < start + size; ++i)
+            {
+                auto& frame = frames[(size_t) i];
+                result.peakIn = juce::jmax (result.peakIn, frame.peakIn);
+                result.peakOut = juce::jmax (result.peakOut, frame.peakOut);
+                result.gainReductionDecibels = juce::jmin (result.gainReductionDecibels, frame.gainReductionDecibels);
+            }
+        };
+
+        combine (start1, size1);
+        combine (start2, size2);
+        fifo.finishedRead (size1 + size2);
+        return true;
+    }
+
+private:
+    static constexpr int capacity = 128;
+    juce::AbstractFifo fifo { capacity };
+    std::array<MeterFrame, capacity> frames;
+};
+
+//==============================================================================
+/**
+    Horizontal bar meter. setLevel() only repaints when the bar actually moves,
+    and only this component's bounds are invalidated.
+*/
+class LevelMeter  : public juce::Component
+{
+public:
+    LevelMeter (const juce::String& meterName, bool fillsFromRight)
+        : label (meterName), fromRight (fillsFromRight), displayed (fillsFromRight ? 0.0f : minimumDecibels)
+    {
+        setOpaque (false);
+        setInterceptsMouseClicks (false, false);
+    }
+
+    /** Level in dB; gain reduction meters take the (negative) reduction. */
+    void setLevel (float newLevelDecibels)
+    {
+        // Gain reduction is shown as a positive amount growing from the right
+        auto target = fromRight ? -newLevelDecibels : newLevelDecibels;
+        auto lowest = fromRight ? 0.0f : minimumDecibels;
+        auto highest = fromRight ? maximumReduction : maximumDecibels;
+
+        // Instant attack, ~20 dB/s fall at a 30 Hz timer
+        displayed = juce::jlimit (lowest, highest, juce::jmax (target, displayed - 0.7f));
+
+        auto newWidth = juce::roundToInt ((displayed - lowest) / (highest - lowest) * (float) getWidth());
+
+        if (newWidth != barWidth)
+        {
+            barWidth = newWidth;
+            repaint();
+        }
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        auto bounds = getLocalBounds().toFloat();
+
+        g.setColour (juce::Colour::fromFloatRGBA (0, 0, 0, 0.25f));
+        g.fillRoundedRectangle (bounds, 2.0f);
+
+        auto bar = fromRight ? bounds.withLeft (bounds.getRight() - (float) barWidth) : bounds.withWidth ((float) barWidth);
+        g.setColour (juce::Colour::fromFloatRGBA (0.392f, 0.584f, 0.929f, 0.5f));
+        g.fillRoundedRectangle (bar, 2.0f);
+
+        g.setColour (juce::Colour::fromFloatRGBA (1, 1, 1, 0.25f));
+        g.setFont (bounds.getHeight() * 0.7f);
+        g.drawText (label, bounds.reduced (4.0f, 0.0f), fromRight ? juce::Justification::centredLeft : juce::Justification::centredRight);
+    }
+
+private:
+    static constexpr float minimumDecibels = -60.0f, maximumDecibels = 6.0f, maximumReduction = 24.0f;
+
+    juce::String label;
+    bool fromRight;
+    float displayed;
+    int barWidth = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeter)
+};
@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    MultibandCompressor.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ViatorCompressor.h"
+
+//==============================================================================
+/**
+    Splits each channel into 2-5 bands with 4th-order Linkwitz-Riley crossovers,
+    compresses every band with the ViatorCompressor model and sums them back.
+
+    The crossovers are applied as a cascade: each one takes the low band off what
+    is left, and that low band then goes through an all-pass at every higher
+    crossover frequency, so all bands carry the same phase shift and sum flat.
+
+    All band signals live in one contiguous arena allocated in prepare(), laid out
+    band-major, so to a single ViatorCompressor they simply look like
+    numBands * numChannels channels. That packs bands side by side into the SIMD
+    lanes, and a block costs one detector/gain pass over the active bands, with no
+    allocation and no per-band objects to chase.
+
+    Every band detects on its own signal; the linked, mid/side and external
+    detector modes and the key filter only apply to the single-band engine.
+*/
+template <typename SampleType>
+class MultibandCompressor
+{
+public:
+    static constexpr int maximumBands = 5;
+    static constexpr int maximumCrossovers = maximumBands - 1;
+
+    MultibandCompressor()
+    {
+        for (auto& allpass : allpasses)
+            allpass.setType (juce::dsp::LinkwitzRileyFilterType::allpass);
+    }
+
+    //==============================================================================
+    void setThreshold (SampleType newThresholdDecibels) noexcept        { compressor.setThreshold (newThresholdDecibels); }
+    void setRatio (SampleType newRatio) noexcept                        { compressor.setRatio (newRatio); }
+    void setAttack (SampleType newAttackMs) noexcept                    { compressor.setAttack (newAttackMs); }
+    void setRelease (SampleType newReleaseMs) noexcept                  { compressor.setRelease (newReleaseMs); }
+    void setInputGainDecibels (SampleType newGainDecibels) noexcept     { compressor.setInputGainDecibels (newGainDecibels); }
+    void setOutputGainDecibels (SampleType newGainDecibels) noexcept    { compressor.setOutputGainDecibels (newGainDecibels); }
+    void setLookahead (SampleType newLookaheadMs) noexcept              { compressor.setLookahead (newLookaheadMs); }
+    void setRampDurationSeconds (double newDurationSeconds) noexcept    { compressor.setRampDurationSeconds (newDurationSeconds); }
+    void setGainMath (typename ViatorCompressor<SampleType>::GainMath newTier) noexcept { compressor.setGainMath (newTier); }
+    void setLevelDetection (typename ViatorCompressor<SampleType>::LevelDetection newDetection) noexcept { compressor.setLevelDetection (newDetection); }
+    void setRmsWindow (SampleType newWindowMs) noexcept                 { compressor.setRmsWindow (newWindowMs); }
+    void setTransparentFastPath (bool shouldSkip) noexcept              { compressor.setTransparentFastPath (shouldSkip); }
+    void setGainReductionMetering (bool shouldMeter) noexcept           { compressor.setGainReductionMetering (shouldMeter); }
+
+    /** The smallest gain applied to any band of any channel in the last process() call. */
+    SampleType getMinimumGain() const noexcept                          { return compressor.getMinimumGain(); }
+
+    int getLatencySamples() const noexcept                              { return compressor.getLatencySamples(); }
+
+    /** 1 passes the signal through a single band; changing the count resets the bands. */
+    void setNumBands (int newNumBands) noexcept
+    {
+        newNumBands = juce::jlimit (1, maximumBands, newNumBands);
+
+        if (newNumBands != numBands)
+        {
+            numBands = newNumBands;
+            reset();
+        }
+    }
+
+    int getNumBands() const noexcept                                    { return numBands; }
+
+    /** Sets the split between band index and index + 1. Never allocates. */
+    void setCrossoverFrequency (int index, SampleType newFrequencyHz) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (index, maximumCrossovers));
+
+        crossovers[(size_t) index].setCutoffFrequency (newFrequencyHz);
+
+        // Every lower band is phase-matched through an all-pass at this frequency
+        for (auto lower = 0; lower < index; ++lower)
+            getAllpass (lower, index).setCutoffFrequency (newFrequencyHz);
+    }
+
+    //==============================================================================
+    void prepare (const juce::dsp::ProcessSpec& spec)
+    {
+        numChannels = spec.numChannels;
+        maximumBlockSize = spec.maximumBlockSize;
+
+        for (auto& crossover : crossovers)
+            crossover.prepare (spec);
+
+        for (auto& allpass : allpasses)
+            allpass.prepare (spec);
+
+        arena.assign ((size_t) maximumBands * numChannels * maximumBlockSize, SampleType (0));
+        bandChannels.resize ((size_t) maximumBands * numChannels);
+
+        for (size_t i = 0; i < bandChannels.size(); ++i)
+            bandChannels[i] = arena.data() + i * maximumBlockSize;
+
+        compressor.prepare ({ spec.sampleRate, spec.maximumBlockSize, (juce::uint32) bandChannels.size() });
+        reset();
+    }
+
+    /** Moves a prepared instance to a rate no higher than the one it was prepared at.
+        The filters are re-prepared with the same channel count, so nothing is allocated.
+    */
+    void setSampleRate (double newSampleRate) noexcept
+    {
+        const juce::dsp::ProcessSpec spec { newSampleRate, (juce::uint32) maximumBlockSize, (juce::uint32) numChannels };
+
+        for (auto& crossover : crossovers)
+            crossover.prepare (spec);
+
+        for (auto& allpass : allpasses)
+            allpass.prepare (spec);
+
+        compressor.setSampleRate (newSampleRate);
+        reset();
+    }
+
+    /** Frees the band buffers and the compressor's; call prepare() again before processing. */
+    void releaseResources()
+    {
+        std::vector<SampleType>().swap (arena);
+        std::vector<SampleType*>().swap (bandChannels);
+        compressor.releaseResources();
+        maximumBlockSize = 0;
+    }
+
+    void reset() noexcept
+    {
+        for (auto& crossover : crossovers)
+            crossover.reset();
+
+        for (auto& allpass : allpasses)
+            allpass.reset();
+
+        compressor.reset();
+    }
+
+    /** Moves the ramps on as far as process() would have; see ViatorCompressor::skipRamps(). */
+    void skipRamps (size_t numSamples) noexcept                         { compressor.skipRamps (numSamples); }
+
+    //==============================================================================
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numSamples = outputBlock.getNumSamples();
+        const auto numActiveChannels = outputBlock.getNumChannels();
+
+        jassert (numSamples <= maximumBlockSize && numActiveChannels <= numChannels);
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        for (size_t channel = 0; channel < numActiveChannels; ++channel)
+            split (inputBlock.getChannelPointer (channel), channel, numSamples);
+
+        // Bands are laid out band-major: band b of channel c is row b * numChannels + c
+        juce::dsp::AudioBlock<SampleType> bandBlock (bandChannels.data(), (size_t) numBands * numChannels, numSamples);
+        compressor.process (juce::dsp::ProcessContextReplacing<SampleType> (bandBlock));
+
+        for (size_t channel = 0; channel < numActiveChannels; ++channel)
+        {
+            auto* destination = outputBlock.getChannelPointer (channel);
+            juce::FloatVectorOperations::copy (destination, getBand (0, channel), (int) numSamples);
+
+            for (auto band = 1; band < numBands; ++band)
+                juce::FloatVectorOperations::add (destination, getBand (band, channel), (int) numSamples);
+        }
+    }
+
+private:
+    //==============================================================================
+    SampleType* getBand (int band, size_t channel) const noexcept
+    {
+        return bandChannels[(size_t) band * numChannels + channel];
+    }
+
+    juce::dsp::LinkwitzRileyFilter<SampleType>& getAllpass (int band, int crossover) noexcept
+    {
+        return allpasses[(size_t) (band * maximumCrossovers + crossover)];
+    }
+
+    // Runs one filter at a time over the whole block, so each stage's coefficients
+    // and state stay in registers
+    void split (const SampleType* input, size_t channel, size_t numSamples) noexcept
+    {
+        const auto filterChannel = (int) channel;
+        auto* remainder = getBand (numBands - 1, channel);
+        juce::FloatVectorOperations::copy (remainder, input, (int) numSamples);
+
+        for (auto index = 0; index < numBands - 1; ++index)
+        {
+            auto& crossover = crossovers[(size_t) index];
+            auto* low = getBand (index, channel);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                crossover.processSample (filterChannel, remainder[i], low[i], remainder[i]);
+
+            for (auto higher = index + 1; higher < numBands - 1; ++higher)
+            {
+                auto& allpass = getAllpass (index, higher);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    low[i] = allpass.processSample (filterChannel, low[i]);
+            }
+        }
+    }
+
+    //==============================================================================
+    ViatorCompressor<SampleType> compressor;
+    std::array<juce::dsp::LinkwitzRileyFilter<SampleType>, maximumCrossovers> crossovers;
+    std::array<juce::dsp::LinkwitzRileyFilter<SampleType>, maximumCrossovers * maximumCrossovers> allpasses;
+
+    std::vector<SampleType> arena;
+    std::vector<SampleType*> bandChannels;
+    size_t numChannels = 0, maximumBlockSize = 0;
+    int numBands = 1;
+};
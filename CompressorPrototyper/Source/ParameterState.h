@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    ParameterState.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Every parameter's real-world value, in the processor's parameter order: what
+    an A/B slot holds and what a state restore hands to the audio thread.
+*/
+struct ParameterSnapshot
+{
+    static constexpr int maximumParameters = 32;
+
+    std::array<float, maximumParameters> values {};
+    int numValues = 0;
+};
+
+//==============================================================================
+/**
+    The plugin's saved state.
+
+    Version 1 is an 8-byte header (magic, version, record count) followed by one
+    8-byte record per parameter: the hash of its ID and its real-world value,
+    little-endian. A session with hundreds of instances restores without parsing
+    or building a ValueTree, and records are matched by ID so parameters can be
+    added, removed or reordered between versions; any the data doesn't mention
+    go back to their defaults, as they did with the ValueTree state.
+
+    Blobs saved before this format are the APVTS ValueTree written with
+    writeToStream(). They can't start with the magic, so read() falls back to
+    parsing them as before.
+*/
+struct ParameterStateFormat
+{
+    using Parameters = juce::Array<juce::RangedAudioParameter*>;
+
+    static constexpr int magic = 0x54534356;   // "VCST" as little-endian bytes
+    static constexpr int currentVersion = 1;
+    static constexpr int headerSize = 8;
+    static constexpr int recordSize = 8;
+
+    static int getIdHash (const juce::RangedAudioParameter& parameter) noexcept
+    {
+        return parameter.paramID.hashCode();
+    }
+
+    static void write (juce::MemoryBlock& destData, const Parameters& parameters, const ParameterSnapshot& snapshot)
+    {
+        destData.setSize (0);
+        destData.ensureSize ((size_t) (headerSize + recordSize * parameters.size()));
+
+        juce::MemoryOutputStream stream (destData, false);
+        stream.writeInt (magic);
+        stream.writeShort ((short) currentVersion);
+        stream.writeShort ((short) parameters.size());
+
+        for (auto i = 0; i < parameters.size(); ++i)
+        {
+            stream.writeInt (getIdHash (*parameters.getUnchecked (i)));
+            stream.writeFloat (snapshot.values[(size_t) i]);
+        }
+    }
+
+    /** Fills snapshot from either format; returns false, leaving it untouched, for data it can't read. */
+    static bool read (const void* data, int sizeInBytes, const Parameters& parameters,
+                      const juce::Identifier& legacyStateType, ParameterSnapshot& snapshot)
+    {
+        if (sizeInBytes >= headerSize && juce::ByteOrder::littleEndianInt (data) == (juce::uint32) magic)
+            return readBinary (static_cast<const char*> (data), sizeInBytes, parameters, snapshot);
+
+        return readLegacy (data, sizeInBytes, parameters, legacyStateType, snapshot);
+    }
+
+private:
+    static void setDefaults (const Parameters& parameters, ParameterSnapshot& snapshot)
+    {
+        snapshot.numValues = parameters.size();
+
+        for (auto i = 0; i < parameters.size(); ++i)
+        {
+            auto* parameter = parameters.getUnchecked (i);
+            snapshot.values[(size_t) i] = parameter->convertFrom0to1 (parameter->getDefaultValue());
+        }
+    }
+
+    /** Clamps and snaps to the parameter's range, so the value is the one the parameter will hold. */
+    static float toParameterValue (const juce::RangedAudioParameter& parameter, float value)
+    {
+        return parameter.convertFrom0to1 (parameter.convertTo0to1 (value));
+    }
+
+    static bool readBinary (const char* data, int sizeInBytes, const Parameters& parameters, ParameterSnapshot& snapshot)
+    {
+        auto version = (int) juce::ByteOrder::littleEndianShort (data + 4);
+        auto numRecords = (int) juce::ByteOrder::littleEndianShort (data + 6);
+
+        if (version < 1 || version > currentVersion || sizeInBytes < headerSize + recordSize * numRecords)
+            return false;
+
+        ParameterSnapshot result;
+        setDefaults (parameters, result);
+
+        for (auto record = 0; record < numRecords; ++record)
+        {
+            auto* recordData = data + headerSize + recordSize * record;
+            auto idHash = (int) juce::ByteOrder::littleEndianInt (recordData);
+
+            // Usually the same order it was written in, so try that index first
+            auto index = record < parameters.size() && getIdHash (*parameters.getUnchecked (record)) == idHash ? record : -1;
+
+            for (auto i = 0; index < 0 && i < parameters.size(); ++i)
+                if (getIdHash (*parameters.getUnchecked (i)) == idHash)
+                    index = i;
+
+            if (index >= 0)
+            {
+                auto bits = juce::ByteOrder::littleEndianInt (recordData + 4);
+                float value;
+                std::memcpy (&value, &bits, sizeof (value));
+                result.values[(size_t) index] = toParameterValue (*parameters.getUnchecked (index), value);
+            }
+        }
+
+        snapshot = result;
+        return true;
+    }
+
+    static bool readLegacy (const void* data, int sizeInBytes, const Parameters& parameters,
+                            const juce::Identifier& legacyStateType, ParameterSnapshot& snapshot)
+    {
+        auto tree = juce::ValueTree::readFromData (data, (size_t) sizeInBytes);
+
+        if (! tree.hasType (legacyStateType))
+            return false;
+
+        ParameterSnapshot result;
+        setDefaults (parameters, result);
+
+        for (auto i = 0; i < parameters.size(); ++i)
+        {
+            auto* parameter = parameters.getUnchecked (i);
+            auto child = tree.getChildWithProperty ("id", parameter->paramID);
+
+            if (child.hasProperty ("value"))
+                result.values[(size_t) i] = toParameterValue (*parameter, (float) child.getProperty ("value"));
+        }
+
+        snapshot = result;
+        return true;
+    }
+};
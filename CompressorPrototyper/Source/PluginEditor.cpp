@@ -13,10 +13,6 @@
 CompressorPrototyperAudioProcessorEditor::CompressorPrototyperAudioProcessorEditor (CompressorPrototyperAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p)
 {
-    shadowProperties.radius = 15;
-    shadowProperties.offset = juce::Point<int> (-2, 6);
-    dialShadow.setShadowProperties (shadowProperties);
-    
     sliders.reserve(6);
     sliders = {
         &inputSlider, &ratioSlider, &threshSlider, &attackSlider, &releaseSlider, &trimSlider
@@ -41,7 +37,6 @@ CompressorPrototyperAudioProcessorEditor::CompressorPrototyperAudioProcessorEdit
         sliders[i]->setColour(0x1001700, juce::Colour::fromFloatRGBA(1, 1, 1, 0.0f));
         sliders[i]->setColour(0x1001500, juce::Colour::fromFloatRGBA(0, 0, 0, 0.25f));
         sliders[i]->setLookAndFeel(&customDial);
-        sliders[i]->setComponentEffect(&dialShadow);
     }
     
     inputSlider.setRange(-36, 36, 0.5f);
@@ -71,22 +66,31 @@ CompressorPrototyperAudioProcessorEditor::CompressorPrototyperAudioProcessorEdit
     windowBorder.setColour(0x1005400, juce::Colour::fromFloatRGBA(1, 1, 1, 0.25f));
     windowBorder.setColour(0x1005410, juce::Colour::fromFloatRGBA(1, 1, 1, 0.25f));
     
+    addAndMakeVisible(inputMeter);
+    addAndMakeVisible(gainReductionMeter);
+    addAndMakeVisible(outputMeter);
+    
     //Making the window resizable by aspect ratio and setting size
     AudioProcessorEditor::setResizable(true, true);
     AudioProcessorEditor::setResizeLimits(711, 237, 1374, 458);
     AudioProcessorEditor::getConstrainer()->setFixedAspectRatio(3.0);
+    setOpaque(true);
     setSize (711, 237);
+    
+    audioProcessor.setMeteringEnabled(true);
+    startTimerHz(30);
 }
 
 CompressorPrototyperAudioProcessorEditor::~CompressorPrototyperAudioProcessorEditor()
 {
+    stopTimer();
+    audioProcessor.setMeteringEnabled(false);
 }
 
 //==============================================================================
 void CompressorPrototyperAudioProcessorEditor::paint (juce::Graphics& g)
 {
-    g.fillAll (juce::Colour::fromFloatRGBA(0.1f, 0.12f, 0.16f, 1.0));
-        
+    // The gradient is opaque and covers everything, so there's no need to fill first
     juce::Rectangle<int> background = AudioProcessorEditor::getLocalBounds();
     g.setGradientFill(juce::ColourGradient::vertical(juce::Colour::fromFloatRGBA(0.18f, 0.20f, 0.24f, 1.0), 300 * .01, juce::Colour::fromFloatRGBA(0.12f, 0.14f, 0.18f, 1.0), 300 * .99));
     g.fillRect(background);
@@ -176,4 +180,32 @@ void CompressorPrototyperAudioProcessorEditor::resized()
     /* ============================================================================ */
     
     windowBorder.setBounds(AudioProcessorEditor::getWidth() * .01, AudioProcessorEditor::getHeight() * 0.04, AudioProcessorEditor::getWidth() * .98, AudioProcessorEditor::getHeight() * .90);
+    
+    //meters along the bottom, under the dials
+    juce::Rectangle<int> meterArea (getWidth() / 20, getHeight() * 82 / 100, getWidth() * 9 / 10, getHeight() / 20);
+    auto meterWidth = meterArea.getWidth() / 3;
+    inputMeter.setBounds(meterArea.removeFromLeft(meterWidth).reduced(8, 0));
+    gainReductionMeter.setBounds(meterArea.removeFromLeft(meterWidth).reduced(8, 0));
+    outputMeter.setBounds(meterArea.reduced(8, 0));
+}
+
+void CompressorPrototyperAudioProcessorEditor::timerCallback()
+{
+    // Hosts often just hide the window, so stop the audio thread measuring and do
+    // no drawing at all until we're back on screen
+    auto showing = isShowing();
+    audioProcessor.setMeteringEnabled(showing);
+    
+    if (! showing)
+        return;
+    
+    MeterFrame frame;
+    
+    // Nothing new since the last tick (e.g. transport stopped): let the meters fall
+    if (! audioProcessor.meterFifo.pull(frame))
+        frame = {};
+    
+    inputMeter.setLevel(juce::Decibels::gainToDecibels(frame.peakIn, -60.0f));
+    gainReductionMeter.setLevel(frame.gainReductionDecibels);
+    outputMeter.setLevel(juce::Decibels::gainToDecibels(frame.peakOut, -60.0f));
 }
@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "SharedResources.h"
 
 //==============================================================================
 /**
@@ -17,31 +18,108 @@
 
 class ViatorDial : public juce::LookAndFeel_V4{
 public:
+    /** With the cache off, every repaint redraws the body from scratch as it used to. */
+    void setImageCacheEnabled (bool shouldCache) { useImageCache = shouldCache; cache.clear(); }
+    
     void drawRotarySlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPos, float rotaryStartAngle, float rotaryEndAngle, juce::Slider &slider) override{
         
         float diameter = fmin(width, height) * 0.65;
         float radius = diameter * 0.5;
         float centerX = x + width * 0.5;
         float centerY = y + height * 0.5;
-        float rx = centerX - radius;
-        float ry = centerY - radius;
         float angle = rotaryStartAngle + (sliderPos * (rotaryEndAngle - rotaryStartAngle));
         
-        juce::Rectangle<float> dialArea (rx, ry, diameter, diameter);
-        g.setColour(juce::Colour::fromFloatRGBA(0.15, 0.15, 0.15, 1)); //center
-        g.setGradientFill(juce::ColourGradient::horizontal(juce::Colour::fromFloatRGBA(0.1, 0.1, 0.1, 1), centerY * .25, juce::Colour::fromFloatRGBA(0.15, 0.15, 0.15, 1), centerY * 2.5));
-        g.fillEllipse(dialArea);
+        if (useImageCache)
+        {
+            // The body and its shadow don't depend on the value, so they're rendered once per
+            // size and display scale, shared by every editor in the process, then just blitted
+            // under the tick on every repaint
+            auto& body = getCachedBody(slider.getLocalBounds(), { x, y, width, height }, g.getInternalContext().getPhysicalPixelScaleFactor());
+            g.drawImage(body, slider.getLocalBounds().toFloat());
+        }
+        else
+        {
+            drawBody(g, x, y, width, height);
+        }
+        
+        if (radius != tickRadius)
+        {
+            dialTick.clear();
+            dialTick.addRectangle(0, -radius + 3, 3.0f, radius * 0.452211);
+            tickRadius = radius;
+        }
+        
         g.setColour(juce::Colour::fromFloatRGBA(0.392f, 0.584f, 0.929f, 0.5f)); //tick color
-
-        juce::Path dialTick;
-        dialTick.addRectangle(0, -radius + 3, 3.0f, radius * 0.452211);
         g.fillPath(dialTick, juce::AffineTransform::rotation(angle).translated(centerX, centerY));
+    }
+
+private:
+    static juce::Rectangle<float> getDialArea(int x, int y, int width, int height)
+    {
+        float diameter = fmin(width, height) * 0.65;
+        float radius = diameter * 0.5;
+        return { x + width * 0.5f - radius, y + height * 0.5f - radius, diameter, diameter };
+    }
+    
+    static void drawBody(juce::Graphics &g, int x, int y, int width, int height)
+    {
+        auto dialArea = getDialArea(x, y, width, height);
+        float centerY = y + height * 0.5;
+        
+        g.setGradientFill(juce::ColourGradient::horizontal(juce::Colour::fromFloatRGBA(0.1, 0.1, 0.1, 1), centerY * .25, juce::Colour::fromFloatRGBA(0.15, 0.15, 0.15, 1), centerY * 2.5));
+        g.fillEllipse(dialArea);
         g.setColour(juce::Colour::fromFloatRGBA(0, 0, 0, .25)); //outline
-        g.drawEllipse(rx, ry, diameter, diameter, 1.0f);
+        g.drawEllipse(dialArea, 1.0f);
     }
+    
+    const juce::Image& getCachedBody(juce::Rectangle<int> sliderBounds, juce::Rectangle<int> dialBounds, float scale)
+    {
+        for (auto& entry : cache)
+            if (entry.sliderBounds == sliderBounds && entry.dialBounds == dialBounds && entry.scale == scale)
+                return *entry.image;
+        
+        // Sizes only change while resizing the window, so a handful of entries is plenty
+        if (cache.size() >= 8)
+            cache.erase(cache.begin());
+        
+        // Every dial draws the same body, so another editor may already have rendered this one
+        auto key = sliderBounds.toString() + " " + dialBounds.toString() + " " + juce::String(scale);
+        auto image = SharedResources::get<juce::Image>(key, [&]
+        {
+            auto newImage = std::make_shared<juce::Image>(juce::Image::ARGB, juce::jmax(1, juce::roundToInt(sliderBounds.getWidth() * scale)), juce::jmax(1, juce::roundToInt(sliderBounds.getHeight() * scale)), true);
+            
+            {
+                juce::Graphics imageGraphics (*newImage);
+                imageGraphics.addTransform(juce::AffineTransform::scale(scale));
+                
+                juce::Path body;
+                body.addEllipse(getDialArea(dialBounds.getX(), dialBounds.getY(), dialBounds.getWidth(), dialBounds.getHeight()));
+                dialShadow.drawForPath(imageGraphics, body);
+                drawBody(imageGraphics, dialBounds.getX(), dialBounds.getY(), dialBounds.getWidth(), dialBounds.getHeight());
+            }
+            
+            return newImage;
+        });
+        
+        cache.push_back({ sliderBounds, dialBounds, scale, image });
+        return *cache.back().image;
+    }
+    
+    struct CachedBody
+    {
+        juce::Rectangle<int> sliderBounds, dialBounds;
+        float scale;
+        std::shared_ptr<const juce::Image> image;
+    };
+    
+    std::vector<CachedBody> cache;
+    juce::DropShadow dialShadow { juce::Colour (0x90000000), 15, { -2, 6 } };
+    juce::Path dialTick;
+    float tickRadius = -1.0f;
+    bool useImageCache = true;
 };
 
-class CompressorPrototyperAudioProcessorEditor  : public juce::AudioProcessorEditor
+class CompressorPrototyperAudioProcessorEditor  : public juce::AudioProcessorEditor, private juce::Timer
 {
 public:
     CompressorPrototyperAudioProcessorEditor (CompressorPrototyperAudioProcessor&);
@@ -52,6 +130,8 @@ public:
     void resized() override;
 
 private:
+    void timerCallback() override;
+    
     
     juce::Slider inputSlider, ratioSlider, threshSlider, attackSlider, releaseSlider, trimSlider;
     std::vector<juce::Slider*> sliders;
@@ -59,6 +139,8 @@ private:
     
     juce::GroupComponent windowBorder;
     
+    LevelMeter inputMeter { "In", false }, gainReductionMeter { "GR", true }, outputMeter { "Out", false };
+    
     juce::Label inputLabel, ratioLabel, threshLabel, attackLabel, releaseLabel, trimLabel;
     std::vector<juce::Label*> labels;
     
@@ -71,8 +153,6 @@ private:
     std::vector<std::string> labelTexts;
     
     ViatorDial customDial;
-    juce::DropShadow shadowProperties;
-    juce::DropShadowEffect dialShadow;
     
     CompressorPrototyperAudioProcessor& audioProcessor;
 
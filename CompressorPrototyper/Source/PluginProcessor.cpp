@@ -16,6 +16,7 @@ CompressorPrototyperAudioProcessor::CompressorPrototyperAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
@@ -23,6 +24,92 @@ CompressorPrototyperAudioProcessor::CompressorPrototyperAudioProcessor()
 treeState (*this, nullptr, "PARAMETER", createParameterLayout())
 #endif
 {
+    rawInput = treeState.getRawParameterValue(inputGainSliderId);
+    rawRatio = treeState.getRawParameterValue(ratioSliderId);
+    rawThresh = treeState.getRawParameterValue(threshSliderId);
+    rawAttack = treeState.getRawParameterValue(attackSliderId);
+    rawRelease = treeState.getRawParameterValue(releaseSliderId);
+    rawTrim = treeState.getRawParameterValue(outputGainSliderId);
+    rawLookahead = treeState.getRawParameterValue(lookaheadSliderId);
+    rawDetector = treeState.getRawParameterValue(detectorSliderId);
+    rawKeyFilter = treeState.getRawParameterValue(keyFilterButtonId);
+    rawKeyFreq = treeState.getRawParameterValue(keyFreqSliderId);
+    rawOversampling = treeState.getRawParameterValue(oversamplingSliderId);
+    rawOversamplingFilter = treeState.getRawParameterValue(oversamplingFilterSliderId);
+    rawBands = treeState.getRawParameterValue(bandsSliderId);
+    rawLinkGroups = treeState.getRawParameterValue(linkGroupsSliderId);
+    rawDetection = treeState.getRawParameterValue(detectionSliderId);
+    rawRmsWindow = treeState.getRawParameterValue(rmsWindowSliderId);
+    
+    for (size_t i = 0; i < rawCrossovers.size(); ++i)
+        rawCrossovers[i] = treeState.getRawParameterValue(crossoverSliderId + juce::String(i + 1));
+    
+    for (auto* parameter : getParameters())
+    {
+        auto* ranged = static_cast<juce::RangedAudioParameter*> (parameter);
+        jassert (stateParameters.size() < ParameterSnapshot::maximumParameters);
+        
+        // Saved states match parameters by ID hash, so two IDs must never share one
+        for (auto* other : stateParameters)
+            jassert (ParameterStateFormat::getIdHash(*other) != ParameterStateFormat::getIdHash(*ranged));
+        
+        rawParameters[(size_t) stateParameters.size()] = treeState.getRawParameterValue(ranged->paramID);
+        stateParameters.add(ranged);
+    }
+    
+    auto indexOf = [this] (const std::atomic<float>* raw)
+    {
+        auto index = (int) std::distance(rawParameters.begin(), std::find(rawParameters.begin(), rawParameters.end(), raw));
+        jassert (index < stateParameters.size());
+        return index;
+    };
+    
+    inputIndex = indexOf(rawInput);
+    ratioIndex = indexOf(rawRatio);
+    threshIndex = indexOf(rawThresh);
+    attackIndex = indexOf(rawAttack);
+    releaseIndex = indexOf(rawRelease);
+    trimIndex = indexOf(rawTrim);
+    lookaheadIndex = indexOf(rawLookahead);
+    detectorIndex = indexOf(rawDetector);
+    keyFilterIndex = indexOf(rawKeyFilter);
+    keyFreqIndex = indexOf(rawKeyFreq);
+    oversamplingIndex = indexOf(rawOversampling);
+    oversamplingFilterIndex = indexOf(rawOversamplingFilter);
+    bandsIndex = indexOf(rawBands);
+    linkGroupsIndex = indexOf(rawLinkGroups);
+    detectionIndex = indexOf(rawDetection);
+    rmsWindowIndex = indexOf(rawRmsWindow);
+    
+    for (size_t i = 0; i < rawCrossovers.size(); ++i)
+        crossoverIndices[i] = indexOf(rawCrossovers[i]);
+    
+    for (auto& snapshot : snapshots)
+        captureSnapshot(snapshot);
+    
+    const std::pair<std::atomic<float>*, float*> lastValueSources[] =
+    {
+        { rawInput, &lastInput }, { rawRatio, &lastRatio }, { rawThresh, &lastThresh }, { rawAttack, &lastAttack },
+        { rawRelease, &lastRelease }, { rawTrim, &lastTrim }, { rawLookahead, &lastLookahead }, { rawDetector, &lastDetector },
+        { rawKeyFilter, &lastKeyFilter }, { rawKeyFreq, &lastKeyFreq }, { rawBands, &lastBands }, { rawLinkGroups, &lastLinkGroups },
+        { rawDetection, &lastDetection }, { rawRmsWindow, &lastRmsWindow }
+    };
+    
+    for (auto i = 0; i < stateParameters.size(); ++i)
+    {
+        for (auto& source : lastValueSources)
+            if (source.first == rawParameters[(size_t) i])
+                lastValues[(size_t) i] = source.second;
+        
+        for (size_t crossover = 0; crossover < rawCrossovers.size(); ++crossover)
+            if (rawCrossovers[crossover] == rawParameters[(size_t) i])
+                lastValues[(size_t) i] = &lastCrossovers[crossover];
+    }
+    
+    usePresetLibrary();
+    
+    // Picks up latency changes made by lookahead and oversampling changes on the audio thread
+    startTimerHz(10);
 }
 
 CompressorPrototyperAudioProcessor::~CompressorPrototyperAudioProcessor()
@@ -30,9 +117,15 @@ CompressorPrototyperAudioProcessor::~CompressorPrototyperAudioProcessor()
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout CompressorPrototyperAudioProcessor::createParameterLayout()
+{
+    auto params = createParameters();
+    return { params.begin(), params.end() };
+}
+
+std::vector<std::unique_ptr<juce::RangedAudioParameter>> CompressorPrototyperAudioProcessor::createParameters()
 {
     std::vector <std::unique_ptr<juce::RangedAudioParameter>> params;
-    params.reserve(6);
+    params.reserve(20);
     
     
     auto inputGainParam = std::make_unique<juce::AudioParameterFloat>(inputGainSliderId, inputGainSliderName, -36.0f, 36.0f, 0.0f);
@@ -41,6 +134,12 @@ juce::AudioProcessorValueTreeState::ParameterLayout CompressorPrototyperAudioPro
     auto attackParam = std::make_unique<juce::AudioParameterInt>(attackSliderId, attackSliderName, 1.0f, 1000.0f, 500.0f);
     auto releaseParam = std::make_unique<juce::AudioParameterFloat>(releaseSliderId, releaseSliderName, 10.0f, 430.0f, 100.0f);
     auto outputGainParam = std::make_unique<juce::AudioParameterFloat>(outputGainSliderId, outputGainSliderName, -36.0f, 36.0f, 0.0f);
+    auto lookaheadParam = std::make_unique<juce::AudioParameterFloat>(lookaheadSliderId, lookaheadSliderName, 0.0f, 10.0f, 0.0f);
+    auto detectorParam = std::make_unique<juce::AudioParameterChoice>(detectorSliderId, detectorSliderName, juce::StringArray { "Channel", "Linked Max", "Linked Mean", "Mid/Side", "External" }, 0);
+    auto keyFilterParam = std::make_unique<juce::AudioParameterBool>(keyFilterButtonId, keyFilterButtonName, false);
+    auto keyFreqParam = std::make_unique<juce::AudioParameterFloat>(keyFreqSliderId, keyFreqSliderName, 20.0f, 500.0f, 80.0f);
+    auto oversamplingParam = std::make_unique<juce::AudioParameterChoice>(oversamplingSliderId, oversamplingSliderName, juce::StringArray { "Off", "2x", "4x", "8x" }, 0);
+    auto oversamplingFilterParam = std::make_unique<juce::AudioParameterChoice>(oversamplingFilterSliderId, oversamplingFilterSliderName, juce::StringArray { "Polyphase IIR", "Linear Phase FIR" }, 0);
     
     params.push_back(std::move(inputGainParam));
     params.push_back(std::move(ratioParam));
@@ -48,8 +147,25 @@ juce::AudioProcessorValueTreeState::ParameterLayout CompressorPrototyperAudioPro
     params.push_back(std::move(attackParam));
     params.push_back(std::move(releaseParam));
     params.push_back(std::move(outputGainParam));
+    params.push_back(std::move(lookaheadParam));
+    params.push_back(std::move(detectorParam));
+    params.push_back(std::move(keyFilterParam));
+    params.push_back(std::move(keyFreqParam));
+    params.push_back(std::move(oversamplingParam));
+    params.push_back(std::move(oversamplingFilterParam));
+    params.push_back(std::make_unique<juce::AudioParameterInt>(bandsSliderId, bandsSliderName, 1, MultibandCompressor<float>::maximumBands, 1));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(detectionSliderId, detectionSliderName, juce::StringArray { "Peak", "RMS" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(rmsWindowSliderId, rmsWindowSliderName, 1.0f, 300.0f, 50.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(linkGroupsSliderId, linkGroupsSliderName, juce::StringArray { "All Channels", "LFE Excluded", "LCR / Surrounds / Heights" }, 0));
     
-    return { params.begin(), params.end() };
+    // Log-ish frequency taper; the defaults make a typical mastering split
+    const float crossoverDefaults[] = { 120.0f, 1000.0f, 4000.0f, 10000.0f };
+    
+    for (auto i = 0; i < MultibandCompressor<float>::maximumCrossovers; ++i)
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(crossoverSliderId + juce::String(i + 1), crossoverSliderName " " + juce::String(i + 1),
+                                                                     juce::NormalisableRange<float>(20.0f, 20000.0f, 1.0f, 0.25f), crossoverDefaults[i]));
+    
+    return params;
 }
 
 //==============================================================================
@@ -85,52 +201,258 @@ bool CompressorPrototyperAudioProcessor::isMidiEffect() const
    #endif
 }
 
+// How long the envelope takes to fall 120 dB once the input stops. The ballistics are
+// one-poles with a time constant of release / 2pi ms, as in juce::BallisticsFilter. An RMS
+// envelope is a mean square, so it has 240 dB to fall, and only starts once its window has
+// emptied, which can take two windows before the fresh sum replaces the running one.
+static double getDecaySeconds (double releaseMs, bool isRms, double rmsWindowMs)
+{
+    auto timeConstants = (isRms ? 240.0 : 120.0) / 20.0 * std::log(10.0);
+    auto windowMs = isRms ? 2.0 * rmsWindowMs : 0.0;
+    return 0.001 * (windowMs + timeConstants * releaseMs / juce::MathConstants<double>::twoPi);
+}
+
 double CompressorPrototyperAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // The delay through the lookahead, oversampling filters and chunk buffer, then the release
+    auto latencySeconds = getSampleRate() > 0.0 ? getLatencySamples() / getSampleRate() : 0.0;
+    return latencySeconds + getDecaySeconds(rawRelease->load(), rawDetection->load() > 0.5f, rawRmsWindow->load());
 }
 
 int CompressorPrototyperAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    requestUserPresets();
+    return presetBank->getNumPresets();
 }
 
 int CompressorPrototyperAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
 void CompressorPrototyperAudioProcessor::setCurrentProgram (int index)
 {
+    // May come from the audio thread (VST3 program changes do), so no more than a few stores
+    if (presetBank->getSnapshot(index) == nullptr)
+        return;
+    
+    currentProgram = index;
+    pendingProgram = index;
+    programToApply = index;
+    
+    if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        requestUserPresets();
+        applyPendingProgram();
+    }
 }
 
 const juce::String CompressorPrototyperAudioProcessor::getProgramName (int index)
 {
-    return {};
+    requestUserPresets();
+    return presetBank->getName(index);
 }
 
 void CompressorPrototyperAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    presetBank->rename(index, newName);
+}
+
+// The presets for one user folder. It decodes them against its own copy of the parameters,
+// in the same order as every instance's, so it doesn't depend on the instance that built it.
+struct CompressorPrototyperAudioProcessor::PresetLibrary
+{
+    PresetLibrary() : parameterStorage(createParameters())
+    {
+        for (auto& parameter : parameterStorage)
+            parameters.add(parameter.get());
+        
+        addFactoryPresets(bank);
+    }
+    
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameterStorage;
+    ParameterStateFormat::Parameters parameters;
+    PresetBank bank { parameters, "PARAMETER" };
+};
+
+void CompressorPrototyperAudioProcessor::usePresetLibrary()
+{
+    presetLibrary = SharedResources::get<PresetLibrary>(userPresetDirectory.getFullPathName(), [] { return std::make_shared<PresetLibrary>(); });
+    presetBank = &presetLibrary->bank;
+    numProgramsReported = presetBank->getNumPresets();
+    
+    for (auto i = 0; i < stateParameters.size(); ++i)
+        jassert (presetLibrary->parameters[i]->paramID == stateParameters[i]->paramID);
+}
+
+void CompressorPrototyperAudioProcessor::setUserPresetDirectory (const juce::File& directory)
+{
+    jassert (! userPresetsRequested);
+    userPresetDirectory = directory;
+    usePresetLibrary();
+}
+
+juce::File CompressorPrototyperAudioProcessor::getDefaultUserPresetDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("Viator").getChildFile(JucePlugin_Name).getChildFile("Presets");
+}
+
+int CompressorPrototyperAudioProcessor::saveUserPreset (const juce::String& name)
+{
+    // The new program joins the folder's, so the host should see the rest of them too
+    requestUserPresets();
+    
+    ParameterSnapshot snapshot;
+    captureSnapshot(snapshot);
+    return presetBank->saveUserPreset(userPresetDirectory, name, snapshot);
+}
+
+void CompressorPrototyperAudioProcessor::addFactoryPresets (PresetBank& bank)
+{
+    bank.addFactoryPreset("Default", {});
+    bank.addFactoryPreset("Gentle Glue", { { ratioSliderId, 2.0f }, { threshSliderId, -8.0f }, { attackSliderId, 300.0f }, { releaseSliderId, 200.0f } });
+    bank.addFactoryPreset("Vocal Leveler", { { ratioSliderId, 3.0f }, { threshSliderId, -14.0f }, { attackSliderId, 150.0f },
+                                             { releaseSliderId, 120.0f }, { detectionSliderId, 1.0f }, { rmsWindowSliderId, 30.0f } });
+    bank.addFactoryPreset("Drum Bus", { { ratioSliderId, 4.0f }, { threshSliderId, -18.0f }, { attackSliderId, 600.0f },
+                                        { releaseSliderId, 60.0f }, { keyFilterButtonId, 1.0f }, { keyFreqSliderId, 100.0f } });
+    bank.addFactoryPreset("Peak Limiter", { { ratioSliderId, 10.0f }, { threshSliderId, -24.0f }, { attackSliderId, 1.0f },
+                                            { releaseSliderId, 50.0f }, { lookaheadSliderId, 5.0f } });
+    bank.addFactoryPreset("Mastering 3-Band", { { ratioSliderId, 2.0f }, { threshSliderId, -10.0f }, { bandsSliderId, 3.0f },
+                                                { detectorSliderId, 1.0f }, { oversamplingSliderId, 1.0f } });
+    bank.addFactoryPreset("Broadcast RMS", { { ratioSliderId, 3.0f }, { threshSliderId, -16.0f }, { detectionSliderId, 1.0f },
+                                             { rmsWindowSliderId, 300.0f }, { detectorSliderId, 2.0f } });
+    bank.addFactoryPreset("Surround Bus", { { ratioSliderId, 2.0f }, { threshSliderId, -12.0f }, { detectorSliderId, 1.0f },
+                                            { linkGroupsSliderId, 2.0f } });
+}
+
+void CompressorPrototyperAudioProcessor::requestUserPresets()
+{
+    // Only once the host or the editor asks about programs, so instances that never show them
+    // don't scan. It runs on the shared loader thread and the programs appear as their files
+    // are decoded.
+    if (userPresetsRequested.exchange(true))
+        return;
+    
+    presetBank->loadUserPresets(userPresetDirectory);
+}
+
+void CompressorPrototyperAudioProcessor::applyPendingProgram()
+{
+    // The audio thread has its own copy of the index and already plays the program
+    auto program = programToApply.exchange(-1);
+    
+    if (program < 0)
+        return;
+    
+    if (auto* snapshot = presetBank->getSnapshot(program))
+        applySnapshot(*snapshot);
 }
 
 //==============================================================================
 void CompressorPrototyperAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    auto channelTypes = getChannelLayoutOfBus(false, 0).getChannelTypes();
+    numMainChannels = juce::jmin(channelTypes.size(), maximumChannels);
+    
+    for (auto i = 0; i < numMainChannels; ++i)
+        mainChannelTypes[(size_t) i] = channelTypes[i];
+    
+    // In chunked mode the DSP only ever sees whole chunks
+    preparedSampleRate = sampleRate;
+    activeChunkSize = requestedChunkSize;
+    preparedBlockSize = activeChunkSize > 0 ? activeChunkSize : juce::jmax(1, samplesPerBlock);
+    
+    // Only the chain for the precision the host asked for is built; the other stays empty
+    if (isUsingDoublePrecision())
+        prepareChain(doubleChain, sampleRate, preparedBlockSize);
+    else
+        prepareChain(floatChain, sampleRate, preparedBlockSize);
+    
+    updateLatency();
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::prepareChain (Chain<SampleType>& chain, double sampleRate, int samplesPerBlock)
+{
+    // Every factor and filter is built now, so a change on the audio thread only picks
+    // another pair and moves the engines to its rate
+    auto numKeyChannels = getBusCount(true) > 1 ? getChannelCountOfBus(true, 1) : 0;
+    
+    auto makeOversampler = [&] (int numChannels, int numStages, int filter) -> std::unique_ptr<juce::dsp::Oversampling<SampleType>>
+    {
+        if (numChannels == 0)
+            return {};
+        
+        auto filterType = filter == 1 ? juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple
+                                      : juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR;
+        auto newOversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>((size_t) numChannels, (size_t) numStages, filterType, true, true);
+        newOversampler->initProcessing((size_t) samplesPerBlock);
+        return newOversampler;
+    };
+    
+    for (auto stages = 1; stages <= maximumOversamplingStages; ++stages)
+    {
+        for (auto filter = 0; filter < 2; ++filter)
+        {
+            chain.oversamplers[(size_t) stages - 1][(size_t) filter] = makeOversampler(getTotalNumOutputChannels(), stages, filter);
+            chain.keyOversamplers[(size_t) stages - 1][(size_t) filter] = makeOversampler(numKeyChannels, stages, filter);
+        }
+    }
+    
+    // The engines are sized for the highest rate; applyOversampling() sets the one in use
+    auto maximumFactor = 1 << maximumOversamplingStages;
+    
     juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = (juce::uint32) (samplesPerBlock * maximumFactor);
+    spec.sampleRate = sampleRate * maximumFactor;
     spec.numChannels = getTotalNumOutputChannels();
     
-    inputGainProcessor.prepare(spec);
-    compressorProcessor.prepare(spec);
-    outputGainProcessor.prepare(spec);
+    chain.inputGainProcessor.setRampDurationSeconds(smoothingTimeSeconds);
+    chain.outputGainProcessor.setRampDurationSeconds(smoothingTimeSeconds);
+    chain.simdCompressorProcessor.setRampDurationSeconds(smoothingTimeSeconds);
+    chain.multibandProcessor.setRampDurationSeconds(smoothingTimeSeconds);
+    chain.simdCompressorProcessor.prepare(spec, (juce::uint32) numKeyChannels);
+    chain.multibandProcessor.prepare(spec);
+    
+    // Set the targets before applyOversampling() resets the engines, so the smoothers start
+    // at rest on the current values
+    updateParameters(chain, true);
+    applyOversampling(chain);
+    
+    chain.chunkBuffer.setSize(juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels()), activeChunkSize);
+    chain.chunkBuffer.clear();
+    chain.chunkFill = 0;
+    chain.silentSamples = 0;
+    numPendingEvents = 0;
 }
 
 void CompressorPrototyperAudioProcessor::releaseResources()
 {
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
+    // Hibernate: free everything prepareToPlay built. The parameters stay, so the next
+    // prepareToPlay rebuilds the chain as it was, starting from rest like a fresh one,
+    // and the latency reported to the host doesn't change in between.
+    releaseChain(floatChain);
+    releaseChain(doubleChain);
+    preparedBlockSize = 0;
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::releaseChain (Chain<SampleType>& chain)
+{
+    chain.simdCompressorProcessor.releaseResources();
+    chain.multibandProcessor.releaseResources();
+    chain.oversampler = chain.keyOversampler = nullptr;
+    chain.oversamplers = {};
+    chain.keyOversamplers = {};
+    chain.chunkBuffer = juce::AudioBuffer<SampleType>();
+    chain.chunkFill = 0;
+    chain.silentSamples = 0;
+    
+    // Their envelopes and ramps are sized per channel; prepareChain() sets every value again
+    chain.compressorProcessor = juce::dsp::Compressor<SampleType>();
+    chain.inputGainProcessor = juce::dsp::Gain<SampleType>();
+    chain.outputGainProcessor = juce::dsp::Gain<SampleType>();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -140,18 +462,28 @@ bool CompressorPrototyperAudioProcessor::isBusesLayoutSupported (const BusesLayo
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Anything from mono up to maximumChannels: stereo, surround layouts such as
+    // 5.1, 7.1 and 7.1.4, or discrete channels for stems
+    if (layouts.getMainOutputChannelSet().isDisabled()
+     || layouts.getMainOutputChannelSet().size() > maximumChannels)
         return false;
 
     // This checks if the input layout matches the output layout
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    // The sidechain key can be off, mono, stereo or the same layout as the main bus
+    if (layouts.inputBuses.size() > 1)
+    {
+        auto sidechain = layouts.getChannelSet(true, 1);
+        
+        if (! sidechain.isDisabled()
+         && sidechain != juce::AudioChannelSet::mono()
+         && sidechain != juce::AudioChannelSet::stereo()
+         && sidechain != layouts.getMainInputChannelSet())
+            return false;
+    }
    #endif
 
     return true;
@@ -160,34 +492,731 @@ bool CompressorPrototyperAudioProcessor::isBusesLayoutSupported (const BusesLayo
 #endif
 
 void CompressorPrototyperAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processHostBlock(buffer, floatChain);
+}
+
+void CompressorPrototyperAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processHostBlock(buffer, doubleChain);
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::processHostBlock (juce::AudioBuffer<SampleType>& buffer, Chain<SampleType>& chain)
 {
     juce::ScopedNoDenormals noDenormals;
+    RealtimeScope realtimeScope;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
+    auto numSamples = buffer.getNumSamples();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
+        buffer.clear (i, 0, numSamples);
+    
+    // A host that processes after releaseResources() without preparing again gets its
+    // audio back untouched rather than the freed buffers
+    jassert (preparedBlockSize > 0);
+    
+    if (preparedBlockSize == 0)
+        return;
+    
+    juce::dsp::AudioBlock<SampleType> block {buffer};
+    
+    if (activeChunkSize == 0)
+    {
+        if (numSamples <= preparedBlockSize)
+        {
+            processChain(block, chain);
+            return;
+        }
+        
+        // Bigger than prepareToPlay promised: run it in pieces the buffers were sized for
+        queuePendingEvents(0, numSamples);
+        
+        for (auto start = 0; start < numSamples; start += preparedBlockSize)
+        {
+            auto length = juce::jmin(preparedBlockSize, numSamples - start);
+            schedulePieceEvents(start + length < numSamples ? length : std::numeric_limits<int>::max());
+            processChain(block.getSubBlock((size_t) start, (size_t) length), chain);
+        }
+        
+        return;
+    }
     
-    juce::dsp::AudioBlock<float> audioBlock {buffer};
+    // Fixed chunks: each host sample goes into the chunk being filled and the sample in
+    // its place, processed one chunk earlier, comes back out. The chunk runs once full,
+    // so the DSP always sees the same pieces whatever the host's block size.
+    queuePendingEvents(chain.chunkFill, numSamples);
+    auto numChannels = juce::jmin(buffer.getNumChannels(), chain.chunkBuffer.getNumChannels());
+    
+    for (auto position = 0; position < numSamples;)
+    {
+        auto length = juce::jmin(numSamples - position, activeChunkSize - chain.chunkFill);
+        
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            auto* host = buffer.getWritePointer(channel, position);
+            std::swap_ranges(host, host + length, chain.chunkBuffer.getWritePointer(channel, chain.chunkFill));
+        }
+        
+        position += length;
+        chain.chunkFill += length;
+        
+        if (chain.chunkFill == activeChunkSize)
+        {
+            schedulePieceEvents(activeChunkSize);
+            processChain(juce::dsp::AudioBlock<SampleType> (chain.chunkBuffer), chain);
+            chain.chunkFill = 0;
+        }
+    }
+}
 
-    auto* rawInput = treeState.getRawParameterValue(inputGainSliderId);
-    auto* rawRatio = treeState.getRawParameterValue(ratioSliderId);
-    auto* rawThresh = treeState.getRawParameterValue(threshSliderId);
-    auto* rawAttack = treeState.getRawParameterValue(attackSliderId);
-    auto* rawRelease = treeState.getRawParameterValue(releaseSliderId);
-    auto* rawTrim = treeState.getRawParameterValue(outputGainSliderId);
+void CompressorPrototyperAudioProcessor::queuePendingEvents (int pieceOffset, int blockLength) noexcept
+{
+    // Offsets become relative to the start of the next piece to run; anything past the
+    // block lands at its end
+    for (auto i = 0; i < numParameterEvents && numPendingEvents < maximumParameterEvents; ++i)
+    {
+        auto event = parameterEvents[(size_t) i];
+        event.sampleOffset = pieceOffset + juce::jmin(event.sampleOffset, blockLength);
+        pendingEvents[(size_t) numPendingEvents++] = event;
+    }
     
-    inputGainProcessor.setGainDecibels(*rawInput);
-    inputGainProcessor.process(juce::dsp::ProcessContextReplacing<float> (audioBlock));
+    numParameterEvents = 0;
+}
 
-    compressorProcessor.setRatio(*rawRatio);
-    compressorProcessor.setThreshold(*rawThresh - 30);
-    compressorProcessor.setAttack(*rawAttack);
-    compressorProcessor.setRelease(*rawRelease);
-    compressorProcessor.process(juce::dsp::ProcessContextReplacing<float> (audioBlock));
+void CompressorPrototyperAudioProcessor::schedulePieceEvents (int length) noexcept
+{
+    // Hands the piece about to run the events due inside it; the rest move up to the next
+    auto numDue = 0;
+    
+    while (numDue < numPendingEvents && pendingEvents[(size_t) numDue].sampleOffset < length)
+        ++numDue;
+    
+    std::copy(pendingEvents.begin(), pendingEvents.begin() + numDue, parameterEvents.begin());
+    numParameterEvents = numDue;
+    
+    for (auto i = numDue; i < numPendingEvents; ++i)
+    {
+        pendingEvents[(size_t) (i - numDue)] = pendingEvents[(size_t) i];
+        pendingEvents[(size_t) (i - numDue)].sampleOffset -= length;
+    }
+    
+    numPendingEvents -= numDue;
+}
 
-    outputGainProcessor.setGainDecibels(*rawTrim);
-    outputGainProcessor.process(juce::dsp::ProcessContextReplacing<float> (audioBlock));
+template <typename SampleType>
+static SampleType getPeak (const juce::dsp::AudioBlock<SampleType>& block)
+{
+    auto range = block.findMinAndMax();
+    return juce::jmax(-range.getStart(), range.getEnd());
+}
+
+template <typename SampleType>
+static bool isSilent (const juce::dsp::AudioBlock<SampleType>& block)
+{
+    // Stops at the first sample that isn't zero, so a block with signal costs next to nothing
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* samples = block.getChannelPointer(channel);
+        
+        if (std::any_of(samples, samples + block.getNumSamples(), [] (SampleType sample) { return sample != SampleType (0); }))
+            return false;
+    }
+    
+    return true;
+}
+
+template <typename SampleType>
+bool CompressorPrototyperAudioProcessor::skipSilence (Chain<SampleType>& chain, const juce::dsp::AudioBlock<SampleType>& block)
+{
+    // Once every input, key included, has been digital silence for longer than the tail,
+    // the output is silence too and the envelopes have nothing left to fall. The block is
+    // left as it is and the engines keep their state for when the signal comes back.
+    if (! useFastPaths || ! isSilent(block))
+    {
+        chain.silentSamples = 0;
+        return false;
+    }
+    
+    auto numSamples = (int) block.getNumSamples();
+    auto tailSamples = getChainLatencySamples(chain) - activeChunkSize
+                     + (int) std::ceil(getDecaySeconds(lastRelease, lastDetection > 0.5f, lastRmsWindow) * getSampleRate());
+    auto isPastTail = chain.silentSamples >= tailSamples;
+    
+    chain.silentSamples = juce::jmin(chain.silentSamples + numSamples, std::numeric_limits<int>::max() / 2);
+    return isPastTail;
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::skipRamps (Chain<SampleType>& chain, int numSamples)
+{
+    // A skipped block moves every ramp on as far as processEngines() would have, so a change
+    // made during the silence sounds the same when the signal comes back
+    auto numSteps = numSamples * oversamplingFactor;
+    
+    if (useSimdCompressor)
+    {
+        if (chain.multibandProcessor.getNumBands() > 1)
+            chain.multibandProcessor.skipRamps((size_t) numSteps);
+        else
+            chain.simdCompressorProcessor.skipRamps((size_t) numSteps);
+        
+        chain.thresholdSmoother.skip(numSteps);
+    }
+    else
+    {
+        // A step at a time, as processing would have taken them, so the values match to the bit
+        for (auto* gain : { &chain.inputGainProcessor, &chain.outputGainProcessor })
+            for (auto i = 0; i < numSteps && gain->isSmoothing(); ++i)
+                gain->processSample(SampleType (0));
+        
+        for (auto i = 0; i < numSteps && chain.thresholdSmoother.isSmoothing(); ++i)
+            chain.thresholdSmoother.getNextValue();
+    }
+    
+    chain.compressorProcessor.setThreshold(chain.thresholdSmoother.getCurrentValue());
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::processChain (juce::dsp::AudioBlock<SampleType> block, Chain<SampleType>& chain)
+{
+    // Only the main bus is compressed; the sidechain channels are just a key
+    auto audioBlock = block.getSubsetChannelBlock(0, (size_t) getMainBusNumOutputChannels());
+    
+    // Automation timestamped inside the block starts from the values the DSP already has.
+    // A piece of a split block runs that way too while events wait for a later piece,
+    // or it would take the host's values, already at the block's end, too early.
+    auto isAutomated = numParameterEvents > 0 || numPendingEvents > 0;
+    
+    if (isAutomated)
+        beginAutomatedBlock();
+    
+    updateParameters(chain, false, isAutomated ? &automationValues : nullptr);
+    
+    // Only switched here, between blocks, never in the middle of an oversampled one
+    if (lastOversampling != activeOversampling || lastOversamplingFilter != activeOversamplingFilter)
+        applyOversampling(chain);
+    
+    // Meters cost two extra reads of the block, so skip them while no editor is open
+    auto isMetering = meteringEnabled.load();
+    auto peakIn = isMetering ? getPeak(audioBlock) : SampleType (0);
+    
+    if (! isAutomated && skipSilence(chain, block))
+    {
+        skipRamps(chain, (int) audioBlock.getNumSamples());
+        
+        if (isMetering)
+            publishMeters(0.0f, 0.0f, 1.0f);
+        
+        return;
+    }
+    
+    chain.minimumGain = SampleType (1);
+    
+    // The whole gain chain runs oversampled, so the gain modulation doesn't alias
+    auto processingBlock = chain.oversampler != nullptr ? chain.oversampler->processSamplesUp(audioBlock) : audioBlock;
+    
+    // Only the SIMD engines take a key
+    juce::dsp::AudioBlock<SampleType> sidechainBlock;
+    
+    if (useSimdCompressor && getBusCount(true) > 1 && getChannelCountOfBus(true, 1) > 0)
+        sidechainBlock = block.getSubsetChannelBlock((size_t) getChannelIndexInProcessBlockBuffer(true, 1, 0), (size_t) getChannelCountOfBus(true, 1));
+    
+    if (chain.keyOversampler != nullptr && sidechainBlock.getNumChannels() > 0)
+        sidechainBlock = chain.keyOversampler->processSamplesUp(sidechainBlock);
+    
+    if (isAutomated)
+        processAutomated(chain, processingBlock, sidechainBlock);
+    else
+        processEngines(chain, processingBlock, sidechainBlock);
+    
+    if (chain.oversampler != nullptr)
+        chain.oversampler->processSamplesDown(audioBlock);
+    
+    if (isMetering)
+        publishMeters((float) peakIn, (float) getPeak(audioBlock), (float) chain.minimumGain);
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::processEngines (Chain<SampleType>& chain, juce::dsp::AudioBlock<SampleType> block, juce::dsp::AudioBlock<SampleType> sidechainBlock)
+{
+    if (useSimdCompressor)
+    {
+        // Fused input gain -> compressor -> trim in a single pass over the buffer (over every
+        // band at once in multiband mode). The SIMD engines ramp their own threshold; keep
+        // ours, and the juce::dsp compressor it feeds, in step for when we switch back.
+        if (chain.multibandProcessor.getNumBands() > 1)
+        {
+            chain.multibandProcessor.process(juce::dsp::ProcessContextReplacing<SampleType> (block));
+            chain.minimumGain = juce::jmin(chain.minimumGain, chain.multibandProcessor.getMinimumGain());
+        }
+        else
+        {
+            chain.simdCompressorProcessor.process(juce::dsp::ProcessContextReplacing<SampleType> (block), sidechainBlock);
+            chain.minimumGain = juce::jmin(chain.minimumGain, chain.simdCompressorProcessor.getMinimumGain());
+        }
+        
+        chain.thresholdSmoother.skip((int) block.getNumSamples());
+        chain.compressorProcessor.setThreshold(chain.thresholdSmoother.getCurrentValue());
+    }
+    else
+    {
+        // A gain stage resting at 0 dB would multiply by exactly 1. The compressor always
+        // runs, so its envelope is current when the ratio moves off 1.
+        auto isUnity = [this] (const juce::dsp::Gain<SampleType>& gain)
+        {
+            return useFastPaths && ! gain.isSmoothing() && gain.getGainLinear() == SampleType (1);
+        };
+        
+        if (! isUnity(chain.inputGainProcessor))
+            chain.inputGainProcessor.process(juce::dsp::ProcessContextReplacing<SampleType> (block));
+
+        // juce::dsp::Compressor doesn't report its gain, so the meters need the per-sample loop too
+        auto isMetering = meteringEnabled.load();
+        
+        if (chain.thresholdSmoother.isSmoothing() || isMetering)
+            processCompressorPerSample(chain, block, isMetering);
+        else
+            chain.compressorProcessor.process(juce::dsp::ProcessContextReplacing<SampleType> (block));
+
+        if (! isUnity(chain.outputGainProcessor))
+            chain.outputGainProcessor.process(juce::dsp::ProcessContextReplacing<SampleType> (block));
+    }
+}
+
+bool CompressorPrototyperAudioProcessor::addParameterEvent (int parameterIndex, int sampleOffset, float value) noexcept
+{
+    if (numParameterEvents == maximumParameterEvents
+        || ! juce::isPositiveAndBelow(parameterIndex, stateParameters.size())
+        || lastValues[(size_t) parameterIndex] == nullptr)
+        return false;
+    
+    // Hosts send them in order, so this is normally an append
+    auto position = numParameterEvents;
+    
+    while (position > 0 && parameterEvents[(size_t) position - 1].sampleOffset > sampleOffset)
+    {
+        parameterEvents[(size_t) position] = parameterEvents[(size_t) position - 1];
+        --position;
+    }
+    
+    parameterEvents[(size_t) position] = { juce::jmax(0, sampleOffset), parameterIndex, value };
+    ++numParameterEvents;
+    return true;
+}
+
+void CompressorPrototyperAudioProcessor::beginAutomatedBlock()
+{
+    // A parameter with events, in this piece or a later one, holds the value the DSP has
+    // until its first one; the host has usually already moved it to its last. The others
+    // take the host's value as usual.
+    captureSnapshot(automationValues);
+    
+    auto hold = [this] (const ParameterEvent& event)
+    {
+        auto index = (size_t) event.parameterIndex;
+        automationValues.values[index] = *lastValues[index];
+    };
+    
+    std::for_each(parameterEvents.begin(), parameterEvents.begin() + numParameterEvents, hold);
+    std::for_each(pendingEvents.begin(), pendingEvents.begin() + numPendingEvents, hold);
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::processAutomated (Chain<SampleType>& chain, juce::dsp::AudioBlock<SampleType>& block, juce::dsp::AudioBlock<SampleType>& sidechainBlock)
+{
+    // Runs the engines up to each event, then applies it. Their state carries across the
+    // pieces, so the output matches one pass until the first change lands.
+    auto numSamples = block.getNumSamples();
+    auto hasKey = sidechainBlock.getNumChannels() > 0;
+    size_t start = 0;
+    
+    auto processUpTo = [&] (size_t end)
+    {
+        if (end > start)
+            processEngines(chain, block.getSubBlock(start, end - start),
+                           hasKey ? sidechainBlock.getSubBlock(start, end - start) : sidechainBlock);
+        
+        start = end;
+    };
+    
+    for (auto i = 0; i < numParameterEvents;)
+    {
+        // Offsets are at the host rate; the block may be oversampled
+        auto offset = juce::jmin(numSamples, (size_t) parameterEvents[(size_t) i].sampleOffset * (size_t) oversamplingFactor);
+        processUpTo(offset);
+        
+        // Everything due at this sample lands together
+        for (; i < numParameterEvents && juce::jmin(numSamples, (size_t) parameterEvents[(size_t) i].sampleOffset * (size_t) oversamplingFactor) == offset; ++i)
+            automationValues.values[(size_t) parameterEvents[(size_t) i].parameterIndex] = parameterEvents[(size_t) i].value;
+        
+        updateParameters(chain, false, &automationValues);
+    }
+    
+    processUpTo(numSamples);
+    numParameterEvents = 0;
+}
+
+void CompressorPrototyperAudioProcessor::publishMeters (float peakIn, float peakOut, float minimumGain)
+{
+    MeterFrame frame;
+    frame.peakIn = peakIn;
+    frame.peakOut = peakOut;
+    
+    frame.gainReductionDecibels = juce::jmin(0.0f, juce::Decibels::gainToDecibels(minimumGain, -100.0f));
+    
+    meterFifo.push(frame);
+}
+
+// Link group of one main bus channel for each choice of the link groups parameter:
+// all channels together, all but the LFE, or LCR / surrounds / heights with the LFE
+// on its own. Discrete channels have no role, so they link with the fronts.
+static int getLinkGroup (int scheme, juce::AudioChannelSet::ChannelType type)
+{
+    using Set = juce::AudioChannelSet;
+    
+    if (scheme == 0)
+        return 0;
+    
+    if (type == Set::LFE || type == Set::LFE2)
+        return ViatorCompressor<float>::unlinked;
+    
+    if (scheme == 1)
+        return 0;
+    
+    switch (type)
+    {
+        case Set::leftSurround:
+        case Set::rightSurround:
+        case Set::centreSurround:
+        case Set::surround:
+        case Set::leftSurroundSide:
+        case Set::rightSurroundSide:
+        case Set::leftSurroundRear:
+        case Set::rightSurroundRear:
+            return 1;
+            
+        case Set::topMiddle:
+        case Set::topFrontLeft:
+        case Set::topFrontCentre:
+        case Set::topFrontRight:
+        case Set::topRearLeft:
+        case Set::topRearCentre:
+        case Set::topRearRight:
+            return 2;
+            
+        default:
+            return 0;
+    }
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::applyOversampling (Chain<SampleType>& chain)
+{
+    // Everything was built in prepareChain(), so this only picks the pair for the setting and
+    // moves the engines to its rate. Nothing allocates, and each starts from rest, as after a
+    // re-prepare; the sudden change in delay makes a discontinuity either way.
+    activeOversampling = lastOversampling;
+    activeOversamplingFilter = lastOversamplingFilter;
+    
+    auto numStages = juce::jlimit(0, maximumOversamplingStages, (int) activeOversampling);
+    auto filter = activeOversamplingFilter > 0.5f ? 1 : 0;
+    
+    chain.oversampler = numStages > 0 ? chain.oversamplers[(size_t) numStages - 1][(size_t) filter].get() : nullptr;
+    chain.keyOversampler = numStages > 0 ? chain.keyOversamplers[(size_t) numStages - 1][(size_t) filter].get() : nullptr;
+    
+    for (auto* oversampler : { chain.oversampler, chain.keyOversampler })
+        if (oversampler != nullptr)
+            oversampler->reset();
+    
+    oversamplingFactor = 1 << numStages;
+    
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = (juce::uint32) (preparedBlockSize * oversamplingFactor);
+    spec.sampleRate = preparedSampleRate * oversamplingFactor;
+    spec.numChannels = getTotalNumOutputChannels();
+    
+    // Same channel count as before, so the juce::dsp processors only resize to the sizes they have
+    chain.inputGainProcessor.prepare(spec);
+    chain.compressorProcessor.prepare(spec);
+    chain.outputGainProcessor.prepare(spec);
+    chain.simdCompressorProcessor.setSampleRate(spec.sampleRate);
+    chain.multibandProcessor.setSampleRate(spec.sampleRate);
+    chain.thresholdSmoother.reset(spec.sampleRate, smoothingTimeSeconds);
+    chain.compressorProcessor.setThreshold(chain.thresholdSmoother.getTargetValue());
+    chain.silentSamples = 0;
+    
+    // Telling the host takes its listener lock, so leave that to timerCallback()
+    pendingLatencySamples = computeLatencySamples();
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::updateParameters (Chain<SampleType>& chain, bool forceUpdate, const ParameterSnapshot* automation)
+{
+    // A recalled set lands whole in this block, and is read from its slot until the
+    // parameters all hold it; failing that, a program change sounds from this block,
+    // before its parameters move. Either outranks automation.
+    if ((recallMiddle.load() & recallPendingBit) != 0)
+        recallReadSlot = recallMiddle.exchange(recallReadSlot) & recallSlotMask;
+    
+    auto& recalled = recallSlots[(size_t) recallReadSlot];
+    auto* snapshot = recalled.version > recallLandedVersion.load() ? &recalled.values : nullptr;
+    auto* values = snapshot != nullptr ? snapshot : automation;
+    
+    auto program = pendingProgram.exchange(-1);
+    
+    if (program >= 0)
+    {
+        if (auto* preset = presetBank->getSnapshot(program))
+        {
+            programValues = *preset;
+            numHeld = programValues.numValues;
+            
+            for (auto i = 0; i < numHeld; ++i)
+            {
+                programBaseline.values[(size_t) i] = rawParameters[(size_t) i]->load();
+                isHeld[(size_t) i] = true;
+            }
+        }
+    }
+    
+    // A recall replaces the whole set, program included
+    if (snapshot != nullptr && numHeld > 0)
+    {
+        isHeld.fill(false);
+        numHeld = 0;
+    }
+    
+    // Each held parameter lets go once the host's value leaves where it stood when the
+    // program came in, or automation in this block moves it
+    if (numHeld > 0)
+    {
+        heldValues.numValues = programValues.numValues;
+        
+        for (size_t i = 0; i < (size_t) programValues.numValues; ++i)
+        {
+            auto current = rawParameters[i]->load();
+            auto automated = automation != nullptr ? automation->values[i] : current;
+            
+            if (isHeld[i] && (current != programBaseline.values[i] || (automated != current && automated != programValues.values[i])))
+            {
+                isHeld[i] = false;
+                --numHeld;
+            }
+            
+            heldValues.values[i] = isHeld[i] ? programValues.values[i] : automated;
+        }
+        
+        values = &heldValues;
+    }
+    
+    auto changed = [this, forceUpdate, values] (int index, float& lastValue)
+    {
+        auto value = readParameter(values, index);
+        
+        if (! forceUpdate && value == lastValue)
+            return false;
+        
+        lastValue = value;
+        return true;
+    };
+    
+    if (changed(inputIndex, lastInput))
+    {
+        chain.inputGainProcessor.setGainDecibels(lastInput);
+        chain.simdCompressorProcessor.setInputGainDecibels(lastInput);
+        chain.multibandProcessor.setInputGainDecibels(lastInput);
+    }
+
+    if (changed(ratioIndex, lastRatio))
+    {
+        chain.compressorProcessor.setRatio(lastRatio);
+        chain.simdCompressorProcessor.setRatio(lastRatio);
+        chain.multibandProcessor.setRatio(lastRatio);
+    }
+
+    if (changed(threshIndex, lastThresh))
+    {
+        chain.thresholdSmoother.setTargetValue(lastThresh - 30);
+        chain.simdCompressorProcessor.setThreshold(lastThresh - 30);
+        chain.multibandProcessor.setThreshold(lastThresh - 30);
+    }
+
+    if (changed(attackIndex, lastAttack))
+    {
+        chain.compressorProcessor.setAttack(lastAttack);
+        chain.simdCompressorProcessor.setAttack(lastAttack);
+        chain.multibandProcessor.setAttack(lastAttack);
+    }
+
+    if (changed(releaseIndex, lastRelease))
+    {
+        chain.compressorProcessor.setRelease(lastRelease);
+        chain.simdCompressorProcessor.setRelease(lastRelease);
+        chain.multibandProcessor.setRelease(lastRelease);
+    }
+
+    if (changed(trimIndex, lastTrim))
+    {
+        chain.outputGainProcessor.setGainDecibels(lastTrim);
+        chain.simdCompressorProcessor.setOutputGainDecibels(lastTrim);
+        chain.multibandProcessor.setOutputGainDecibels(lastTrim);
+    }
+    
+    if (changed(detectorIndex, lastDetector))
+        chain.simdCompressorProcessor.setDetectorMode(static_cast<typename ViatorCompressor<SampleType>::DetectorMode> ((int) lastDetector));
+    
+    // RMS only exists in the SIMD engines; juce::dsp::Compressor always follows the peak
+    if (changed(detectionIndex, lastDetection))
+    {
+        auto detection = lastDetection > 0.5f ? ViatorCompressor<SampleType>::LevelDetection::rms : ViatorCompressor<SampleType>::LevelDetection::peak;
+        chain.simdCompressorProcessor.setLevelDetection(detection);
+        chain.multibandProcessor.setLevelDetection(detection);
+    }
+    
+    if (changed(rmsWindowIndex, lastRmsWindow))
+    {
+        chain.simdCompressorProcessor.setRmsWindow(lastRmsWindow);
+        chain.multibandProcessor.setRmsWindow(lastRmsWindow);
+    }
+    
+    // Only the linked detector modes use the groups
+    if (changed(linkGroupsIndex, lastLinkGroups))
+    {
+        std::array<int, maximumChannels> groups {};
+        
+        for (auto i = 0; i < numMainChannels; ++i)
+            groups[(size_t) i] = getLinkGroup((int) lastLinkGroups, mainChannelTypes[(size_t) i]);
+        
+        chain.simdCompressorProcessor.setLinkGroups(groups.data(), (size_t) numMainChannels);
+    }
+    
+    // Evaluate both so the last values stay in sync
+    auto keyFilterChanged = changed(keyFilterIndex, lastKeyFilter);
+    
+    if (changed(keyFreqIndex, lastKeyFreq) || keyFilterChanged)
+        chain.simdCompressorProcessor.setKeyFilter(lastKeyFilter > 0.5f, lastKeyFreq);
+    
+    if (changed(bandsIndex, lastBands))
+        chain.multibandProcessor.setNumBands((int) lastBands);
+    
+    auto crossoversChanged = false;
+    
+    for (size_t i = 0; i < rawCrossovers.size(); ++i)
+        crossoversChanged = changed(crossoverIndices[i], lastCrossovers[i]) || crossoversChanged;
+    
+    // Each split is kept at or above the one below it, so the bands never overlap
+    if (crossoversChanged)
+    {
+        auto lowerFrequency = 0.0f;
+        
+        for (size_t i = 0; i < lastCrossovers.size(); ++i)
+        {
+            lowerFrequency = juce::jmax(lowerFrequency, lastCrossovers[i]);
+            chain.multibandProcessor.setCrossoverFrequency((int) i, lowerFrequency);
+        }
+    }
+    
+    // An engine option rather than a parameter, and only an enum store, so just apply it
+    auto gainMath = useFastGainMath ? ViatorCompressor<SampleType>::GainMath::fast : ViatorCompressor<SampleType>::GainMath::exact;
+    chain.simdCompressorProcessor.setGainMath(gainMath);
+    chain.multibandProcessor.setGainMath(gainMath);
+    chain.simdCompressorProcessor.setTransparentFastPath(useFastPaths);
+    chain.multibandProcessor.setTransparentFastPath(useFastPaths);
+    chain.simdCompressorProcessor.setGainReductionMetering(meteringEnabled);
+    chain.multibandProcessor.setGainReductionMetering(meteringEnabled);
+    
+    // processChain() applies these at the start of the next block
+    changed(oversamplingIndex, lastOversampling);
+    changed(oversamplingFilterIndex, lastOversamplingFilter);
+    
+    if (changed(lookaheadIndex, lastLookahead))
+    {
+        chain.simdCompressorProcessor.setLookahead(lastLookahead);
+        chain.multibandProcessor.setLookahead(lastLookahead);
+        
+        // Telling the host takes its listener lock, so leave that to timerCallback()
+        pendingLatencySamples = computeLatencySamples();
+    }
+    
+    if (forceUpdate)
+        chain.compressorProcessor.setThreshold(chain.thresholdSmoother.getTargetValue());
+}
+
+float CompressorPrototyperAudioProcessor::readParameter (const ParameterSnapshot* snapshot, int index) const noexcept
+{
+    // Snapshots are in getParameters() order, so a set being recalled or automated is read directly
+    if (snapshot != nullptr && index < snapshot->numValues)
+        return snapshot->values[(size_t) index];
+    
+    return rawParameters[(size_t) index]->load();
+}
+
+void CompressorPrototyperAudioProcessor::updateLatency()
+{
+    auto latency = computeLatencySamples();
+    pendingLatencySamples = latency;
+    
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+int CompressorPrototyperAudioProcessor::computeLatencySamples()
+{
+    return isUsingDoublePrecision() ? getChainLatencySamples(doubleChain) : getChainLatencySamples(floatChain);
+}
+
+template <typename SampleType>
+int CompressorPrototyperAudioProcessor::getChainLatencySamples (Chain<SampleType>& chain)
+{
+    // Lookahead only exists in the SIMD engine and is counted at the oversampled rate;
+    // the oversampling filters and the chunk buffer add their own delay on top
+    auto lookahead = useSimdCompressor ? chain.simdCompressorProcessor.getLatencySamples() : 0;
+    auto filterLatency = chain.oversampler != nullptr ? (double) chain.oversampler->getLatencyInSamples() : 0.0;
+    
+    return juce::roundToInt(filterLatency + (double) lookahead / (double) oversamplingFactor) + activeChunkSize;
+}
+
+void CompressorPrototyperAudioProcessor::timerCallback()
+{
+    // Program changes made off the message thread, and user presets as they load
+    applyPendingProgram();
+    
+    if (presetBank->getNumPresets() != numProgramsReported)
+    {
+        numProgramsReported = presetBank->getNumPresets();
+        updateHostDisplay();
+    }
+    
+    auto latency = pendingLatencySamples.load();
+    
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::processCompressorPerSample (Chain<SampleType>& chain, juce::dsp::AudioBlock<SampleType>& audioBlock, bool trackGain)
+{
+    // Only runs while the threshold is ramping or the meters want the gain; juce::dsp::Compressor
+    // has no per-sample threshold, so we step it here and feed the channels one sample at a time.
+    auto numChannels = (int) audioBlock.getNumChannels();
+    
+    for (auto sample = 0; sample < (int) audioBlock.getNumSamples(); ++sample)
+    {
+        if (chain.thresholdSmoother.isSmoothing())
+            chain.compressorProcessor.setThreshold(chain.thresholdSmoother.getNextValue());
+        
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            auto input = audioBlock.getSample(channel, sample);
+            auto output = chain.compressorProcessor.processSample(channel, input);
+            audioBlock.setSample(channel, sample, output);
+            
+            if (trackGain && std::abs(input) > SampleType (1.0e-6))
+                chain.minimumGain = juce::jmin(chain.minimumGain, output / input);
+        }
+    }
 }
 
 //==============================================================================
@@ -204,18 +1233,84 @@ juce::AudioProcessorEditor* CompressorPrototyperAudioProcessor::createEditor()
 //==============================================================================
 void CompressorPrototyperAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    juce::MemoryOutputStream stream(destData, false);
-        treeState.state.writeToStream (stream);
+    ParameterSnapshot snapshot;
+    captureSnapshot(snapshot);
+    ParameterStateFormat::write(destData, stateParameters, snapshot);
 }
 
 void CompressorPrototyperAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    juce::ValueTree tree = juce::ValueTree::readFromData (data, size_t (sizeInBytes));
-        if (tree.isValid()) {
-            treeState.state = tree;
-        }
+    // Reads both the compact format and the ValueTree blobs older versions saved
+    ParameterSnapshot snapshot;
+    
+    if (ParameterStateFormat::read(data, sizeInBytes, stateParameters, treeState.state.getType(), snapshot))
+        applySnapshot(snapshot);
+}
+
+void CompressorPrototyperAudioProcessor::storeSnapshot (int slot)
+{
+    jassert (juce::isPositiveAndBelow(slot, numSnapshots));
+    const juce::ScopedLock lock(snapshotLock);
+    captureSnapshot(snapshots[(size_t) slot]);
+}
+
+void CompressorPrototyperAudioProcessor::recallSnapshot (int slot)
+{
+    jassert (juce::isPositiveAndBelow(slot, numSnapshots));
+    const juce::ScopedLock lock(snapshotLock);
+    applySnapshot(snapshots[(size_t) slot]);
+}
+
+void CompressorPrototyperAudioProcessor::captureSnapshot (ParameterSnapshot& snapshot) const
+{
+    snapshot.numValues = stateParameters.size();
+    
+    for (auto i = 0; i < snapshot.numValues; ++i)
+        snapshot.values[(size_t) i] = rawParameters[(size_t) i]->load();
+}
+
+void CompressorPrototyperAudioProcessor::applySnapshot (const ParameterSnapshot& snapshot)
+{
+    const juce::ScopedLock lock(snapshotLock);
+    
+    // A listener may apply another set from inside the loop below, so work from a copy
+    auto values = snapshot;
+    auto version = ++recallVersion;
+    
+    auto& slot = recallSlots[(size_t) recallWriteSlot];
+    slot.values = values;
+    slot.version = version;
+    recallWriteSlot = recallMiddle.exchange(recallWriteSlot | recallPendingBit) & recallSlotMask;
+    
+    // Hosts and the editor follow the parameters; the audio thread is already reading
+    // the published set, so it doesn't see these land one at a time
+    for (auto i = 0; i < values.numValues; ++i)
+    {
+        auto* parameter = stateParameters.getUnchecked(i);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(values.values[(size_t) i]));
+    }
+    
+    // The parameters hold the set now, so the audio thread goes back to reading them.
+    // A newer set applied from inside the loop has already said so for itself.
+    if (version > recallLandedVersion.load())
+        recallLandedVersion.store(version);
 }
 
+template <typename SampleType>
+void CompressorPrototyperAudioProcessor::copySettingsTo (BatchCompressor<SampleType>& batch, size_t index) const
+{
+    // The same mapping as updateParameters()
+    batch.setInputGainDecibels(index, rawInput->load());
+    batch.setRatio(index, rawRatio->load());
+    batch.setThreshold(index, rawThresh->load() - 30);
+    batch.setAttack(index, rawAttack->load());
+    batch.setRelease(index, rawRelease->load());
+    batch.setOutputGainDecibels(index, rawTrim->load());
+}
+
+template void CompressorPrototyperAudioProcessor::copySettingsTo<float> (BatchCompressor<float>&, size_t) const;
+template void CompressorPrototyperAudioProcessor::copySettingsTo<double> (BatchCompressor<double>&, size_t) const;
+
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
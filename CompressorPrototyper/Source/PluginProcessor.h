@@ -9,6 +9,14 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ViatorCompressor.h"
+#include "MultibandCompressor.h"
+#include "BatchCompressor.h"
+#include "LevelMeter.h"
+#include "ParameterState.h"
+#include "PresetBank.h"
+#include "SharedResources.h"
+#include "RealtimeScope.h"
 
 #define inputGainSliderId "inputGain"
 #define inputGainSliderName "Input Gain"
@@ -28,16 +36,57 @@
 #define outputGainSliderId "outputGain"
 #define outputGainSliderName "Output Gain"
 
+#define lookaheadSliderId "lookahead"
+#define lookaheadSliderName "Lookahead"
+
+#define detectorSliderId "detector"
+#define detectorSliderName "Detector"
+
+#define keyFilterButtonId "keyFilter"
+#define keyFilterButtonName "Key Filter"
+
+#define keyFreqSliderId "keyFreq"
+#define keyFreqSliderName "Key HPF"
+
+#define oversamplingSliderId "oversampling"
+#define oversamplingSliderName "Oversampling"
+
+#define oversamplingFilterSliderId "oversamplingFilter"
+#define oversamplingFilterSliderName "OS Filter"
+
+#define bandsSliderId "bands"
+#define bandsSliderName "Bands"
+
+#define detectionSliderId "detection"
+#define detectionSliderName "Detection"
+
+#define rmsWindowSliderId "rmsWindow"
+#define rmsWindowSliderName "RMS Window"
+
+#define linkGroupsSliderId "linkGroups"
+#define linkGroupsSliderName "Link Groups"
+
+// Crossovers are numbered from 1, e.g. "crossover1" / "Crossover 1"
+#define crossoverSliderId "crossover"
+#define crossoverSliderName "Crossover"
+
 //==============================================================================
 /**
 */
-class CompressorPrototyperAudioProcessor  : public juce::AudioProcessor
+class CompressorPrototyperAudioProcessor  : public juce::AudioProcessor,
+                                            private juce::Timer
 {
 public:
     //==============================================================================
     CompressorPrototyperAudioProcessor();
     ~CompressorPrototyperAudioProcessor() override;
 
+    /** The widest main bus accepted, named surround layout or discrete. */
+    static constexpr int maximumChannels = 64;
+
+    /** Oversampling runs off, 2x, 4x or 8x. */
+    static constexpr int maximumOversamplingStages = 3;
+
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
@@ -47,6 +96,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -74,10 +125,254 @@ public:
     juce::AudioProcessorValueTreeState treeState;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    /** A/B compare: storeSnapshot() copies the current settings into slot 0 (A) or 1 (B),
+        recallSnapshot() brings them back. The audio thread takes a recalled set all in
+        one block, never half old and half new.
+    */
+    static constexpr int numSnapshots = 2;
+    void storeSnapshot (int slot);
+    void recallSnapshot (int slot);
+
+    /** The programs are the factory presets followed by the user presets in this folder,
+        which loads in the background, once per process for every instance using it. Set
+        it before the host first asks about programs or starts processing.
+    */
+    static juce::File getDefaultUserPresetDirectory();
+    void setUserPresetDirectory (const juce::File& directory);
+    bool isLoadingUserPresets() const { return presetBank->isLoadingUserPresets(); }
+
+    /** Saves the current settings as a user preset; returns its program index, or -1 if the file couldn't be written. */
+    int saveUserPreset (const juce::String& name);
+
+    /** Sample-accurate automation. Call on the audio thread before processBlock, once per
+        change: the index into getParameters(), the sample offset into the coming block
+        and the new value in real-world units. As hosts do, also leave the parameter at
+        its last value in the block. The block is split at each offset; without events it
+        runs in one piece as before. Returns false if the event can't be queued: too many
+        this block, or the oversampling settings, which only switch between blocks.
+    */
+    bool addParameterEvent (int parameterIndex, int sampleOffset, float value) noexcept;
+    static constexpr int maximumParameterEvents = 512;
+
+    /** Chooses between the SIMD ViatorCompressor and juce::dsp::Compressor.
+        The envelopes aren't carried across, so switch while the transport is stopped.
+    */
+    void setUseSimdCompressor (bool shouldUseSimd) noexcept { useSimdCompressor = shouldUseSimd; updateLatency(); }
+    bool isUsingSimdCompressor() const noexcept { return useSimdCompressor; }
+
+    /** Runs the SIMD engines' gain computer on FastGainMath's polynomials instead of
+        std::pow; see ViatorCompressor::getMaximumErrorDecibels() for the error bound.
+    */
+    void setUseFastGainMath (bool shouldUseFastMath) noexcept { useFastGainMath = shouldUseFastMath; }
+    bool isUsingFastGainMath() const noexcept { return useFastGainMath; }
+
+    /** Skips work that can't change the output (on by default): blocks of digital silence
+        once the tail has died away, and the gain stages while the ratio is 1 and both gains
+        rest at 0 dB. The detectors keep running at ratio 1, so nothing jumps when it moves.
+    */
+    void setUseFastPaths (bool shouldSkip) noexcept { useFastPaths = shouldSkip; }
+    bool isUsingFastPaths() const noexcept { return useFastPaths; }
+
+    /** Runs the DSP in fixed chunks of this many samples (16 to 1024) for hosts that call
+        with tiny blocks, at the cost of that many samples of latency; the output is then
+        the same whatever the host's block size. 0, the default, processes the host's
+        blocks as they come, split only where they're longer than prepareToPlay said.
+        Takes effect at the next prepareToPlay.
+    */
+    void setChunkSize (int numSamples) noexcept { requestedChunkSize = numSamples == 0 ? 0 : juce::jlimit(16, 1024, numSamples); }
+    int getChunkSize() const noexcept { return activeChunkSize; }
+
+    /** Peak and gain reduction per block, published only while metering is enabled. The
+        gain reduction is the smallest gain the compressor itself applied in the block,
+        gain stages excluded.
+    */
+    MeterFifo meterFifo;
+    void setMeteringEnabled (bool shouldMeter) noexcept { meteringEnabled = shouldMeter; }
+
+    /** Copies this instance's threshold, ratio, attack, release and gains into compressor
+        index of a batch, for a host that runs its mono channels as one BatchCompressor.
+        The batch has only the peak, per-channel detector with no lookahead, oversampling
+        or bands, and it keeps its own gain math tier.
+    */
+    template <typename SampleType>
+    void copySettingsTo (BatchCompressor<SampleType>& batch, size_t index) const;
+
 private:
-    juce::dsp::Compressor<float> compressorProcessor;
-    juce::dsp::Gain<float> inputGainProcessor;
-    juce::dsp::Gain<float> outputGainProcessor;
+    /** Everything that runs at the host's sample type. Both precisions share one
+        templated code path; only the chain matching isUsingDoublePrecision() is prepared.
+    */
+    template <typename SampleType>
+    struct Chain
+    {
+        juce::dsp::Compressor<SampleType> compressorProcessor;
+        ViatorCompressor<SampleType> simdCompressorProcessor;
+        MultibandCompressor<SampleType> multibandProcessor;
+        juce::dsp::Gain<SampleType> inputGainProcessor;
+        juce::dsp::Gain<SampleType> outputGainProcessor;
+        juce::SmoothedValue<SampleType> thresholdSmoother;
+        
+        // Every factor and filter is built in prepareToPlay, [stages - 1][filter], so the
+        // audio thread can switch between them; the key gets its own so an external
+        // sidechain arrives at the same rate
+        using Oversamplers = std::array<std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, 2>, maximumOversamplingStages>;
+        Oversamplers oversamplers, keyOversamplers;
+        
+        // The pair in use, or null when oversampling is off
+        juce::dsp::Oversampling<SampleType>* oversampler = nullptr;
+        juce::dsp::Oversampling<SampleType>* keyOversampler = nullptr;
+        
+        // Every input channel of the chunk being filled, in chunked mode
+        juce::AudioBuffer<SampleType> chunkBuffer;
+        int chunkFill = 0;
+        
+        // Consecutive samples of digital silence on every input, at the host rate
+        int silentSamples = 0;
+        
+        // The smallest gain the compressor applied this block, for the gain reduction meter
+        SampleType minimumGain = 1;
+    };
+    
+    template <typename SampleType> void prepareChain (Chain<SampleType>& chain, double sampleRate, int samplesPerBlock);
+    template <typename SampleType> void releaseChain (Chain<SampleType>& chain);
+    template <typename SampleType> void processHostBlock (juce::AudioBuffer<SampleType>& buffer, Chain<SampleType>& chain);
+    template <typename SampleType> void processChain (juce::dsp::AudioBlock<SampleType> block, Chain<SampleType>& chain);
+    template <typename SampleType> void applyOversampling (Chain<SampleType>& chain);
+    template <typename SampleType> void updateParameters (Chain<SampleType>& chain, bool forceUpdate, const ParameterSnapshot* automation = nullptr);
+    template <typename SampleType> void processEngines (Chain<SampleType>& chain, juce::dsp::AudioBlock<SampleType> block, juce::dsp::AudioBlock<SampleType> sidechainBlock);
+    template <typename SampleType> void processAutomated (Chain<SampleType>& chain, juce::dsp::AudioBlock<SampleType>& block, juce::dsp::AudioBlock<SampleType>& sidechainBlock);
+    template <typename SampleType> bool skipSilence (Chain<SampleType>& chain, const juce::dsp::AudioBlock<SampleType>& block);
+    template <typename SampleType> void skipRamps (Chain<SampleType>& chain, int numSamples);
+    template <typename SampleType> int getChainLatencySamples (Chain<SampleType>& chain);
+    template <typename SampleType> void processCompressorPerSample (Chain<SampleType>& chain, juce::dsp::AudioBlock<SampleType>& audioBlock, bool trackGain);
+    
+    void updateLatency();
+    int computeLatencySamples();
+    void timerCallback() override;
+    void publishMeters (float peakIn, float peakOut, float minimumGain);
+    void captureSnapshot (ParameterSnapshot& snapshot) const;
+    void applySnapshot (const ParameterSnapshot& snapshot);
+    float readParameter (const ParameterSnapshot* snapshot, int index) const noexcept;
+    static std::vector<std::unique_ptr<juce::RangedAudioParameter>> createParameters();
+    static void addFactoryPresets (PresetBank& bank);
+    void usePresetLibrary();
+    void requestUserPresets();
+    void applyPendingProgram();
+    void beginAutomatedBlock();
+    void queuePendingEvents (int pieceOffset, int blockLength) noexcept;
+    void schedulePieceEvents (int length) noexcept;
+
+    Chain<float> floatChain;
+    Chain<double> doubleChain;
+    std::atomic<bool> useSimdCompressor { VIATOR_SIMD_COMPRESSOR != 0 };
+    std::atomic<bool> useFastGainMath { VIATOR_FAST_GAIN_MATH != 0 };
+    std::atomic<bool> useFastPaths { true };
+    std::atomic<bool> meteringEnabled { false };
+    std::atomic<int> pendingLatencySamples { 0 };
+    int oversamplingFactor = 1;
+    std::atomic<int> requestedChunkSize { 0 };
+    int activeChunkSize = 0, preparedBlockSize = 0;
+    
+    // Roles of the main bus channels, captured in prepareToPlay so link groups
+    // can be rebuilt on the audio thread without touching the layout
+    std::array<juce::AudioChannelSet::ChannelType, maximumChannels> mainChannelTypes {};
+    int numMainChannels = 0;
+    double preparedSampleRate = 0.0;
+    float activeOversampling = 0.0f, activeOversamplingFilter = 0.0f;
+
+    // Resolved once in the constructor so processBlock never does a string lookup
+    std::atomic<float>* rawInput = nullptr;
+    std::atomic<float>* rawRatio = nullptr;
+    std::atomic<float>* rawThresh = nullptr;
+    std::atomic<float>* rawAttack = nullptr;
+    std::atomic<float>* rawRelease = nullptr;
+    std::atomic<float>* rawTrim = nullptr;
+    std::atomic<float>* rawLookahead = nullptr;
+    std::atomic<float>* rawDetector = nullptr;
+    std::atomic<float>* rawKeyFilter = nullptr;
+    std::atomic<float>* rawKeyFreq = nullptr;
+    std::atomic<float>* rawOversampling = nullptr;
+    std::atomic<float>* rawOversamplingFilter = nullptr;
+    std::atomic<float>* rawBands = nullptr;
+    std::atomic<float>* rawLinkGroups = nullptr;
+    std::atomic<float>* rawDetection = nullptr;
+    std::atomic<float>* rawRmsWindow = nullptr;
+    std::array<std::atomic<float>*, MultibandCompressor<float>::maximumCrossovers> rawCrossovers {};
+    
+    // Where each of the above sits in getParameters() order, so a snapshot is read by index
+    int inputIndex = 0, ratioIndex = 0, threshIndex = 0, attackIndex = 0, releaseIndex = 0, trimIndex = 0, lookaheadIndex = 0;
+    int detectorIndex = 0, keyFilterIndex = 0, keyFreqIndex = 0, oversamplingIndex = 0, oversamplingFilterIndex = 0;
+    int bandsIndex = 0, linkGroupsIndex = 0, detectionIndex = 0, rmsWindowIndex = 0;
+    std::array<int, MultibandCompressor<float>::maximumCrossovers> crossoverIndices {};
+    
+    // Every parameter in getParameters() order, which is the order snapshots use
+    ParameterStateFormat::Parameters stateParameters;
+    std::array<std::atomic<float>*, ParameterSnapshot::maximumParameters> rawParameters {};
+    
+    // A recall or state restore hands its whole set to the audio thread through a triple
+    // buffer, then pushes the values into the parameters. Until they all hold it the audio
+    // thread reads the set from its slot, so it never sees them land one at a time, and
+    // neither side ever waits for the other.
+    struct RecalledSet
+    {
+        ParameterSnapshot values;
+        juce::uint32 version = 0;
+    };
+    
+    static constexpr int recallSlotMask = 3, recallPendingBit = 4;
+    std::array<RecalledSet, 3> recallSlots;
+    std::atomic<int> recallMiddle { 1 };                    // the spare slot, plus recallPendingBit while it holds a newer set
+    int recallWriteSlot = 0;                                // under snapshotLock
+    int recallReadSlot = 2;                                 // audio thread only
+    juce::uint32 recallVersion = 0;                         // under snapshotLock
+    std::atomic<juce::uint32> recallLandedVersion { 0 };    // the newest set the parameters hold
+    std::array<ParameterSnapshot, numSnapshots> snapshots;
+    juce::CriticalSection snapshotLock;   // between message-side callers only
+    
+    // setCurrentProgram() only stores the index, from whatever thread the host calls it on:
+    // once for the audio thread and once for applyPendingProgram() on the message thread.
+    // The audio thread takes its copy at the next block and holds each parameter at the
+    // program's value until the parameter moves from where it stood, whether the message
+    // thread has caught up, a knob moved or automation arrived.
+    struct PresetLibrary;
+    std::shared_ptr<PresetLibrary> presetLibrary;   // shared through SharedResources, per folder
+    PresetBank* presetBank = nullptr;
+    std::atomic<int> currentProgram { 0 }, pendingProgram { -1 }, programToApply { -1 };
+    ParameterSnapshot programValues, programBaseline, heldValues;   // audio thread only
+    std::array<bool, ParameterSnapshot::maximumParameters> isHeld {};
+    int numHeld = 0;
+    juce::File userPresetDirectory { getDefaultUserPresetDirectory() };
+    std::atomic<bool> userPresetsRequested { false };
+    int numProgramsReported = 0;
+
+    // Last values handed to the DSP, so setters only run when a parameter moves
+    float lastInput = 0.0f, lastRatio = 0.0f, lastThresh = 0.0f, lastAttack = 0.0f, lastRelease = 0.0f, lastTrim = 0.0f, lastLookahead = 0.0f;
+    float lastDetector = 0.0f, lastKeyFilter = 0.0f, lastKeyFreq = 0.0f;
+    float lastBands = 0.0f, lastLinkGroups = 0.0f, lastDetection = 0.0f, lastRmsWindow = 0.0f;
+    float lastOversampling = 0.0f, lastOversamplingFilter = 0.0f;
+    std::array<float, MultibandCompressor<float>::maximumCrossovers> lastCrossovers {};
+    
+    // The last value above for each parameter index, or null for the oversampling
+    // settings; automation in a block starts from these
+    std::array<float*, ParameterSnapshot::maximumParameters> lastValues {};
+    
+    // Audio thread only: this block's events in offset order, and the values they build up
+    struct ParameterEvent
+    {
+        int sampleOffset;
+        int parameterIndex;
+        float value;
+    };
+    
+    std::array<ParameterEvent, maximumParameterEvents> parameterEvents;
+    int numParameterEvents = 0;
+    
+    // Events waiting for a later piece when a block is split or buffered into chunks,
+    // with offsets from the start of the next piece to run
+    std::array<ParameterEvent, maximumParameterEvents> pendingEvents;
+    int numPendingEvents = 0;
+    ParameterSnapshot automationValues;
+
+    static constexpr double smoothingTimeSeconds = 0.02;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompressorPrototyperAudioProcessor)
 };
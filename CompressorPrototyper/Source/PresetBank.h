@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterState.h"
+
+//==============================================================================
+/**
+    The programs a host sees: the factory presets, then every preset file in the
+    user's preset folder.
+
+    Each preset is decoded into a ParameterSnapshot once, when it's added, so a
+    program change only hands the audio thread a pointer: getSnapshot() is
+    lock-free and never parses or allocates. Presets and snapshots are only ever
+    appended, into chunks that double in size and never move, so a snapshot pointer
+    stays valid for the bank's lifetime whatever is added after it. Saving over a
+    user preset the bank already has stores a new snapshot and points the preset at
+    it, so the program keeps its index and a reader of the old one is unaffected.
+
+    User presets are the compact state format, one .vcpreset file each. The folder
+    is scanned on a shared background thread and each file is memory-mapped rather
+    than read, so opening the plugin never waits on a large library; presets appear
+    in the bank as they are decoded.
+
+    Every instance using the same folder shares one bank, so a rename or a saved
+    preset shows up in all of them, as the file it changes would. Adding, renaming
+    and starting the scan all take the bank's lock, so instances may do them at once.
+    The scan skips files that are already in the bank, having been saved first.
+*/
+class PresetBank
+{
+public:
+    PresetBank (const ParameterStateFormat::Parameters& parametersToUse, const juce::Identifier& legacyStateTypeToUse)
+        : parameters (parametersToUse), legacyStateType (legacyStateTypeToUse)
+    {
+    }
+
+    ~PresetBank()
+    {
+        // The job appends into this bank, so it must be gone before the bank is. It checks
+        // shouldExit() between files, so waiting with no timeout is at most one file.
+        if (loadJob != nullptr)
+            loaderPool->removeJob (loadJob.get(), true, -1);
+    }
+
+    static constexpr const char* fileExtension = ".vcpreset";
+
+    /** Adds a preset with the given values, in real-world units; every other
+        parameter stays at its default.
+    */
+    void addFactoryPreset (const juce::String& name, std::initializer_list<std::pair<const char*, float>> values)
+    {
+        ParameterSnapshot snapshot;
+        snapshot.numValues = parameters.size();
+
+        for (auto i = 0; i < parameters.size(); ++i)
+        {
+            auto* parameter = parameters.getUnchecked (i);
+            snapshot.values[(size_t) i] = parameter->convertFrom0to1 (parameter->getDefaultValue());
+
+            for (auto& value : values)
+                if (parameter->paramID == value.first)
+                    snapshot.values[(size_t) i] = parameter->convertFrom0to1 (parameter->convertTo0to1 (value.second));
+        }
+
+        append (name, {}, snapshot, false);
+        ++numFactoryPresets;
+    }
+
+    /** Starts scanning the folder in the background; only the first call does anything,
+        whichever instance or thread makes it.
+    */
+    void loadUserPresets (const juce::File& directory)
+    {
+        const juce::ScopedLock lock (writeLock);
+
+        if (loadJob != nullptr)
+            return;
+
+        loadJob = std::make_unique<LoadJob> (*this, directory);
+        loaderPool->addJob (loadJob.get(), false);
+    }
+
+    bool isLoadingUserPresets() const
+    {
+        const juce::ScopedLock lock (writeLock);
+        return loadJob != nullptr && loaderPool->contains (loadJob.get());
+    }
+
+    int getNumPresets() const noexcept                  { return numPresets.load (std::memory_order_acquire); }
+    bool isFactoryPreset (int index) const noexcept     { return juce::isPositiveAndBelow (index, numFactoryPresets); }
+
+    /** Safe from any thread, the audio thread included; null for an index out of range. */
+    const ParameterSnapshot* getSnapshot (int index) const noexcept
+    {
+        if (! juce::isPositiveAndBelow (index, getNumPresets()))
+            return nullptr;
+
+        return getPreset (index).snapshot.load (std::memory_order_acquire);
+    }
+
+    juce::String getName (int index) const
+    {
+        const juce::ScopedLock lock (writeLock);
+        return juce::isPositiveAndBelow (index, getNumPresets()) ? getPreset (index).name : juce::String();
+    }
+
+    /** Renames a preset; for a user preset the file is renamed to match. */
+    void rename (int index, const juce::String& newName)
+    {
+        const juce::ScopedLock lock (writeLock);
+
+        if (! juce::isPositiveAndBelow (index, getNumPresets()) || newName.isEmpty())
+            return;
+
+        auto& preset = getPreset (index);
+        auto newFile = preset.file.getSiblingFile (juce::File::createLegalFileName (newName) + fileExtension);
+
+        if (preset.file != juce::File() && ! newFile.exists() && preset.file.moveFileTo (newFile))
+        {
+            fileIndices.remove (preset.file.getFullPathName());
+            fileIndices.set (newFile.getFullPathName(), index);
+            preset.file = newFile;
+        }
+
+        preset.name = newName;
+    }
+
+    /** Writes the snapshot to the user folder and adds it to the bank, returning its index
+        or -1. Saving over a preset already in the bank updates it in place.
+    */
+    int saveUserPreset (const juce::File& directory, const juce::String& name, const ParameterSnapshot& snapshot)
+    {
+        juce::MemoryBlock data;
+        ParameterStateFormat::write (data, parameters, snapshot);
+
+        auto file = directory.getChildFile (juce::File::createLegalFileName (name) + fileExtension);
+
+        if (! directory.createDirectory() || ! file.replaceWithData (data.getData(), data.getSize()))
+            return -1;
+
+        return append (name, file, snapshot, true);
+    }
+
+private:
+    struct Preset
+    {
+        juce::String name;
+        juce::File file;
+        std::atomic<const ParameterSnapshot*> snapshot { nullptr };
+    };
+
+    // Chunk k holds firstChunkSize << k presets, so maximumChunks of them hold over 130,000
+    static constexpr int firstChunkSize = 32;
+    static constexpr int maximumChunks = 12;
+
+    static int getChunk (int index) noexcept            { return juce::findHighestSetBit ((juce::uint32) (index / firstChunkSize + 1)); }
+    static int getChunkStart (int chunk) noexcept       { return firstChunkSize * ((1 << chunk) - 1); }
+
+    template <typename Item>
+    using Chunks = std::array<std::unique_ptr<Item[]>, maximumChunks>;
+
+    // Allocates the chunk on first use, so only call it under the lock for the next free index
+    template <typename Item>
+    static Item* getItem (Chunks<Item>& itemChunks, int index)
+    {
+        auto chunk = getChunk (index);
+
+        if (chunk >= maximumChunks)
+            return nullptr;
+
+        if (itemChunks[(size_t) chunk] == nullptr)
+            itemChunks[(size_t) chunk].reset (new Item[(size_t) (firstChunkSize << chunk)]);
+
+        return &itemChunks[(size_t) chunk][(size_t) (index - getChunkStart (chunk))];
+    }
+
+    Preset& getPreset (int index) const noexcept
+    {
+        auto chunk = getChunk (index);
+        return chunks[(size_t) chunk][(size_t) (index - getChunkStart (chunk))];
+    }
+
+    /** Adds a preset, or for a file the bank already has, updates it if replaceExisting is set;
+        returns its index, or -1 if it wasn't added.
+    */
+    int append (const juce::String& name, const juce::File& file, const ParameterSnapshot& snapshot, bool replaceExisting)
+    {
+        const juce::ScopedLock lock (writeLock);
+
+        auto path = file.getFullPathName();
+        auto existing = file != juce::File() && fileIndices.contains (path);
+
+        if (existing && ! replaceExisting)
+            return -1;
+
+        auto* storedSnapshot = getItem (snapshotChunks, numSnapshots);
+
+        if (storedSnapshot == nullptr)
+            return -1;
+
+        *storedSnapshot = snapshot;
+        ++numSnapshots;
+
+        if (existing)
+        {
+            auto index = fileIndices[path];
+            auto& preset = getPreset (index);
+            preset.name = name;
+            preset.snapshot.store (storedSnapshot, std::memory_order_release);
+            return index;
+        }
+
+        auto index = getNumPresets();
+        auto* preset = getItem (chunks, index);
+
+        if (preset == nullptr)
+            return -1;
+
+        preset->name = name;
+        preset->file = file;
+        preset->snapshot.store (storedSnapshot, std::memory_order_relaxed);
+
+        if (file != juce::File())
+            fileIndices.set (path, index);
+
+        // Publishes the preset: readers only look below numPresets
+        numPresets.store (index + 1, std::memory_order_release);
+        return index;
+    }
+
+    bool contains (const juce::File& file) const
+    {
+        const juce::ScopedLock lock (writeLock);
+        return fileIndices.contains (file.getFullPathName());
+    }
+
+    //==============================================================================
+    class LoadJob  : public juce::ThreadPoolJob
+    {
+    public:
+        LoadJob (PresetBank& bankToFill, const juce::File& directoryToScan)
+            : juce::ThreadPoolJob ("Preset loader"), bank (bankToFill), directory (directoryToScan)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            auto files = directory.findChildFiles (juce::File::findFiles, false, juce::String ("*") + fileExtension);
+            files.sort();
+
+            for (auto& file : files)
+            {
+                if (shouldExit())
+                    break;
+
+                // Saved from an instance before the scan got here
+                if (bank.contains (file))
+                    continue;
+
+                juce::MemoryMappedFile mappedFile (file, juce::MemoryMappedFile::readOnly);
+                ParameterSnapshot snapshot;
+
+                if (mappedFile.getData() != nullptr
+                    && ParameterStateFormat::read (mappedFile.getData(), (int) mappedFile.getSize(), bank.parameters, bank.legacyStateType, snapshot))
+                    bank.append (file.getFileNameWithoutExtension(), file, snapshot, false);
+            }
+
+            return jobHasFinished;
+        }
+
+    private:
+        PresetBank& bank;
+        juce::File directory;
+    };
+
+    // One loader thread shared by every instance in the process
+    struct LoaderPool  : public juce::ThreadPool
+    {
+        LoaderPool() : juce::ThreadPool (1) {}
+    };
+
+    const ParameterStateFormat::Parameters& parameters;
+    juce::Identifier legacyStateType;
+
+    Chunks<Preset> chunks;
+    std::atomic<int> numPresets { 0 };
+    int numFactoryPresets = 0;
+
+    // A new one for every preset added or saved over; preset pointers into these are swapped, never the snapshots
+    Chunks<ParameterSnapshot> snapshotChunks;
+    int numSnapshots = 0;
+
+    juce::HashMap<juce::String, int> fileIndices;   // user presets by full path
+    juce::CriticalSection writeLock;   // appends, renames, the two above and loadJob; never taken by getSnapshot()
+
+    juce::SharedResourcePointer<LoaderPool> loaderPool;
+    std::unique_ptr<LoadJob> loadJob;
+
+    JUCE_DECLARE_NON_COPYABLE (PresetBank)
+};
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    RealtimeScope.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef VIATOR_REALTIME_CHECKS
+ #define VIATOR_REALTIME_CHECKS 0
+#endif
+
+//==============================================================================
+/**
+    Marks the calling thread as running a realtime callback for as long as the
+    object lives.
+
+    On its own it does nothing. A checker linked into a test harness (see
+    CompressorCLI rtcheck) intercepts malloc/free, mutex locks and blocking calls
+    and reports any made while a scope is active on that thread. Unless the build
+    defines VIATOR_REALTIME_CHECKS=1 the class is empty and compiles away.
+*/
+class RealtimeScope
+{
+public:
+   #if VIATOR_REALTIME_CHECKS
+    RealtimeScope() noexcept                { ++depth(); }
+    ~RealtimeScope() noexcept               { --depth(); }
+
+    static bool isActive() noexcept         { return depth() > 0; }
+
+private:
+    static int& depth() noexcept
+    {
+        static thread_local int scopeDepth = 0;
+        return scopeDepth;
+    }
+   #else
+    RealtimeScope() noexcept {}
+
+    static constexpr bool isActive() noexcept   { return false; }
+   #endif
+};
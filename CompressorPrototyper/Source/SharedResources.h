@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    SharedResources.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Process-wide registry for things every instance would otherwise build its own
+    copy of: resources that never change once built, or that only grow under their
+    own lock, keyed by whatever configuration they depend on (a size and display
+    scale, a folder, a sample rate).
+
+    get() returns the resource for a key and only builds it if no instance is
+    holding one. The pointer it returns keeps the resource alive; the registry
+    only keeps a weak reference, so the resource is freed when its last holder
+    lets go. Keys are per resource type. Thread-safe, and the build runs under the
+    registry's lock, so two instances asking at once never build it twice.
+
+    Locks and may allocate, so never call it from the audio thread.
+*/
+class SharedResources
+{
+public:
+    template <typename Resource, typename BuildFunction>
+    static std::shared_ptr<Resource> get (const juce::String& key, BuildFunction&& build)
+    {
+        if (! isSharingEnabled())
+            return build();
+
+        auto& registry = getRegistry();
+        const juce::ScopedLock lock (registry.lock);
+
+        // Drop the entries nobody holds any more before adding to the map
+        for (auto entry = registry.entries.begin(); entry != registry.entries.end();)
+            entry = entry->second.expired() ? registry.entries.erase (entry) : std::next (entry);
+
+        auto& entry = registry.entries[{ getTypeTag<Resource>(), key }];
+
+        if (auto existing = entry.lock())
+            return std::static_pointer_cast<Resource> (existing);
+
+        std::shared_ptr<Resource> resource = build();
+        entry = resource;
+        return resource;
+    }
+
+    /** With sharing off, get() builds a private copy every time; for measuring what sharing saves. */
+    static void setSharingEnabled (bool shouldShare) noexcept   { getSharingFlag() = shouldShare; }
+    static bool isSharingEnabled() noexcept                     { return getSharingFlag(); }
+
+    /** How many resources are alive and shared right now. */
+    static int getNumResources()
+    {
+        auto& registry = getRegistry();
+        const juce::ScopedLock lock (registry.lock);
+
+        return (int) std::count_if (registry.entries.begin(), registry.entries.end(),
+                                    [] (const auto& entry) { return ! entry.second.expired(); });
+    }
+
+private:
+    struct Registry
+    {
+        juce::CriticalSection lock;
+        std::map<std::pair<const void*, juce::String>, std::weak_ptr<void>> entries;
+    };
+
+    // Holds weak references only, so it can outlive every instance without keeping anything alive
+    static Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    static std::atomic<bool>& getSharingFlag() noexcept
+    {
+        static std::atomic<bool> sharingEnabled { true };
+        return sharingEnabled;
+    }
+
+    // A distinct address per resource type, so types never collide on a key and no RTTI is needed
+    template <typename Resource>
+    static const void* getTypeTag() noexcept
+    {
+        static const char tag = 0;
+        return &tag;
+    }
+};
@@ -0,0 +1,944 @@
+/*
+  ==============================================================================
+
+    ViatorCompressor.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FastGainMath.h"
+
+// Set to 0 to make the processor default to juce::dsp::Compressor
+#ifndef VIATOR_SIMD_COMPRESSOR
+ #define VIATOR_SIMD_COMPRESSOR 1
+#endif
+
+// Set to 1 to make the SIMD engine default to the fast gain math tier
+#ifndef VIATOR_FAST_GAIN_MATH
+ #define VIATOR_FAST_GAIN_MATH 0
+#endif
+
+//==============================================================================
+/**
+    Feed-forward peak compressor with the same ballistics and gain law as
+    juce::dsp::Compressor, but with the channels packed into SIMDRegister lanes
+    (SSE/AVX on x86, NEON on ARM) so every channel's envelope advances in one
+    vector operation.
+
+    Input gain and output trim are fused into the same pass: the input gain is
+    applied while each group of channels is interleaved into a scratch buffer, the
+    envelope follower runs sample by sample across the lanes, the gain computer runs
+    over the envelopes as one contiguous array with the trim folded in, and the
+    result is written straight back to the output. Every sample of the host buffer
+    is read once and written once.
+
+    Threshold and both gains are smoothed per sample internally, with the same
+    linear ramps as juce::dsp::Gain, so the output matches the juce::dsp::Gain ->
+    juce::dsp::Compressor -> juce::dsp::Gain chain to within float rounding of the
+    reordered multiplies (|difference| < 1e-6 relative to full scale).
+
+    With lookahead enabled the detector sees the input as it arrives while the
+    audio path is delayed through a ring buffer allocated in prepare(), so gain
+    reduction is already in place when a transient reaches the output. The
+    delay is reported by getLatencySamples().
+
+    The detector can follow each channel on its own, the max or mean level of all
+    channels, the mid and side signals of a stereo pair, or an external key. The
+    linked and external modes fold the key channels into one level signal first,
+    so the whole link group costs a single envelope. An optional high-pass on the
+    key keeps low end from driving the gain reduction.
+
+    The level fed to the ballistics is either the peak |x| or, in RMS mode, the mean
+    square over a 1-300 ms window. The window is a running sum over a ring allocated
+    in prepare() for the longest window, so every sample costs one add and one
+    subtract whatever the window length; a second sum restarted every window
+    replaces the running one each time it completes, so rounding never accumulates.
+    The RMS envelope stays in the power domain and the gain law takes its square
+    root for free by halving the exponent.
+
+    The gain law runs either on std::pow (GainMath::exact) or on FastGainMath's
+    polynomial log2 / exp2 (GainMath::fast), which vectorises across the lanes and
+    stays within getMaximumErrorDecibels() of the exact gain.
+
+    In the linked modes the channels can be split into up to maximumLinkGroups
+    groups (say LCR, surrounds and heights), each with its own envelope, and any
+    channel can be left unlinked to follow its own level (an LFE, for instance).
+*/
+template <typename SampleType>
+class ViatorCompressor
+{
+public:
+    using Vector = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = Vector::size();
+    static constexpr double maximumLookaheadMs = 10.0;
+    static constexpr double maximumRmsWindowMs = 300.0;
+    static constexpr int maximumLinkGroups = 8;
+    static constexpr size_t maximumLinkedChannels = 64;
+    static constexpr int unlinked = -1;
+
+    enum class DetectorMode
+    {
+        channel,        // one envelope per channel
+        linkedMax,      // one envelope following the loudest channel
+        linkedMean,     // one envelope following the average channel level
+        midSide,        // stereo only: compress mid and side, then decode
+        external        // one envelope following the sidechain input
+    };
+
+    enum class LevelDetection
+    {
+        peak,           // |x|
+        rms             // mean square over the window set by setRmsWindow()
+    };
+
+    enum class GainMath
+    {
+        exact,          // std::pow, float rounding only
+        fast            // FastGainMath polynomials, bounded error
+    };
+
+    /** Worst-case gain error of a tier against the ideal gain law, over thresholds of
+        -60 to 0 dB and ratios of 1 to 10. Checked by CompressorCLI accuracy.
+    */
+    static constexpr double getMaximumErrorDecibels (GainMath tier) noexcept
+    {
+        return tier == GainMath::fast ? FastGainMath<SampleType>::maximumErrorDecibels
+                                      : (std::is_same<SampleType, float>::value ? 1.0e-4 : 1.0e-9);
+    }
+
+    //==============================================================================
+    void setThreshold (SampleType newThresholdDecibels) noexcept    { thresholdDecibels.setTargetValue (newThresholdDecibels); }
+    void setRatio (SampleType newRatio) noexcept                    { jassert (newRatio >= 1); ratioInverse = SampleType (1) / newRatio; }
+    void setAttack (SampleType newAttackMs) noexcept                { attackTime = newAttackMs; update(); }
+    void setRelease (SampleType newReleaseMs) noexcept              { releaseTime = newReleaseMs; update(); }
+    void setInputGainDecibels (SampleType newGainDecibels) noexcept { inputGain.setTargetValue (juce::Decibels::decibelsToGain (newGainDecibels)); }
+    void setOutputGainDecibels (SampleType newGainDecibels) noexcept { outputGain.setTargetValue (juce::Decibels::decibelsToGain (newGainDecibels)); }
+
+    /** Sets the lookahead, up to maximumLookaheadMs. Never allocates. */
+    void setLookahead (SampleType newLookaheadMs) noexcept
+    {
+        lookaheadTime = newLookaheadMs;
+        updateLookahead();
+    }
+
+    int getLatencySamples() const noexcept                          { return (int) lookaheadSamples; }
+
+    void setDetectorMode (DetectorMode newMode) noexcept
+    {
+        // A new mode feeds the RMS windows from different signals, so start them afresh
+        clearRms = clearRms || newMode != detectorMode;
+        detectorMode = newMode;
+    }
+
+    void setGainMath (GainMath newTier) noexcept                    { gainMath = newTier; }
+
+    /** At ratio 1 with both gains resting at 0 dB and no lookahead, the output is the
+        input. With this on (the default) such blocks only run the detector, so the
+        envelopes stay where they'd otherwise be, and skip the gain computer.
+    */
+    void setTransparentFastPath (bool shouldSkipWhenTransparent) noexcept { transparentFastPath = shouldSkipWhenTransparent; }
+
+    /** With this on, process() keeps the smallest gain it applies, for a gain reduction
+        meter; it costs one more pass over the gains of each channel group.
+    */
+    void setGainReductionMetering (bool shouldMeter) noexcept       { gainReductionMetering = shouldMeter; }
+
+    /** The smallest gain the last process() call applied to any channel, output trim not
+        included, so 1 while nothing is compressed or metering is off.
+    */
+    SampleType getMinimumGain() const noexcept                      { return minimumGain; }
+
+    bool isTransparent() const noexcept
+    {
+        return ratioInverse == SampleType (1) && lookaheadSamples == 0
+            && ! inputGain.isSmoothing() && inputGain.getTargetValue() == SampleType (1)
+            && ! outputGain.isSmoothing() && outputGain.getTargetValue() == SampleType (1);
+    }
+
+    /** Switching to RMS starts the windows from silence. */
+    void setLevelDetection (LevelDetection newDetection) noexcept
+    {
+        clearRms = clearRms || newDetection != levelDetection;
+        levelDetection = newDetection;
+    }
+
+    /** Sets the RMS window, 1 ms up to maximumRmsWindowMs. Never allocates; the running
+        sums are rebuilt from the ring at the start of the next block.
+    */
+    void setRmsWindow (SampleType newWindowMs) noexcept
+    {
+        rmsWindowTime = newWindowMs;
+        updateRmsWindow();
+    }
+
+    /** Puts channel i in link group groupOfChannel[i] (0 to maximumLinkGroups - 1, or
+        unlinked) for the linked detector modes. Channels not given, including any past
+        maximumLinkedChannels, stay in group 0. Never allocates.
+    */
+    void setLinkGroups (const int* groupOfChannel, size_t numChannelsToSet) noexcept
+    {
+        clearRms = true;
+        linkGroups.fill (0);
+
+        for (size_t channel = 0; channel < juce::jmin (numChannelsToSet, maximumLinkedChannels); ++channel)
+        {
+            jassert (groupOfChannel[channel] == unlinked || juce::isPositiveAndBelow (groupOfChannel[channel], maximumLinkGroups));
+            linkGroups[channel] = juce::jlimit (unlinked, maximumLinkGroups - 1, groupOfChannel[channel]);
+        }
+    }
+
+    /** Enables a 12 dB/oct high-pass on the detector key. */
+    void setKeyFilter (bool shouldBeEnabled, SampleType newCutoffHz) noexcept
+    {
+        keyFilterEnabled = shouldBeEnabled;
+        keyFilterCutoff = newCutoffHz;
+        updateKeyFilter();
+    }
+
+    void setRampDurationSeconds (double newDurationSeconds) noexcept
+    {
+        rampDurationSeconds = newDurationSeconds;
+
+        if (sampleRate > 0)
+            resetRamps();
+    }
+
+    //==============================================================================
+    void prepare (const juce::dsp::ProcessSpec& spec, juce::uint32 maximumSidechainChannels = 0)
+    {
+        jassert (spec.sampleRate > 0 && spec.numChannels > 0);
+
+        sampleRate = spec.sampleRate;
+        numGroups = (spec.numChannels + numLanes - 1) / numLanes;
+        numKeyGroups = juce::jmax (numGroups, (maximumSidechainChannels + numLanes - 1) / numLanes);
+
+        audio.resize (spec.maximumBlockSize);
+        keys.resize (spec.maximumBlockSize);
+        envelopes.resize (spec.maximumBlockSize);
+        linkedLevels.resize ((size_t) maximumLinkGroups * spec.maximumBlockSize);
+        thresholdInverse.resize (spec.maximumBlockSize);
+        inputGains.resize (spec.maximumBlockSize);
+        outputGains.resize (spec.maximumBlockSize);
+        state.resize (numGroups);
+        keyFilterState.resize (2 * (numKeyGroups + numGroups)); // linked keys, then per-channel detection
+
+        delayCapacity = (size_t) std::ceil (maximumLookaheadMs * 0.001 * sampleRate) + 1;
+        delayLines.resize (numGroups * delayCapacity);
+
+        rmsCapacity = (size_t) std::ceil (maximumRmsWindowMs * 0.001 * sampleRate) + 1;
+        rmsRings.resize (numGroups * rmsCapacity);
+        rmsSums.resize (2 * numGroups); // running, then fresh
+        linkedRmsRings.resize ((size_t) maximumLinkGroups * rmsCapacity);
+
+        resetRamps();
+        update();
+        updateLookahead();
+        updateKeyFilter();
+        updateRmsWindow();
+        reset();
+    }
+
+    /** Moves a prepared engine to a rate no higher than the one it was prepared at,
+        without allocating: the delay and RMS rings were sized for the prepared rate.
+        Starts from rest, like reset(). Blocks must still fit the prepared block size.
+    */
+    void setSampleRate (double newSampleRate) noexcept
+    {
+        jassert (newSampleRate > 0 && (double) (delayCapacity - 1) >= std::floor (maximumLookaheadMs * 0.001 * newSampleRate));
+
+        sampleRate = newSampleRate;
+        resetRamps();
+        update();
+        updateLookahead();
+        updateKeyFilter();
+        updateRmsWindow();
+        reset();
+    }
+
+    /** Frees everything prepare() allocated, keeping the settings, so an instance the
+        host has suspended holds no buffers. Call prepare() again before processing.
+    */
+    void releaseResources()
+    {
+        for (auto* buffer : { &audio, &keys, &envelopes, &state, &delayLines, &keyFilterState, &rmsRings, &rmsSums })
+            std::vector<Vector>().swap (*buffer);
+
+        for (auto* buffer : { &thresholdInverse, &inputGains, &outputGains, &linkedLevels, &linkedRmsRings })
+            std::vector<SampleType>().swap (*buffer);
+
+        numGroups = numKeyGroups = delayCapacity = rmsCapacity = 0;
+    }
+
+    void reset() noexcept
+    {
+        std::fill (state.begin(), state.end(), Vector::expand (0));
+        std::fill (delayLines.begin(), delayLines.end(), Vector::expand (0));
+        std::fill (keyFilterState.begin(), keyFilterState.end(), Vector::expand (0));
+        linkedEnvelopes.fill (0);
+        clearRmsWindows();
+        delayWritePosition = 0;
+        thresholdDecibels.setCurrentAndTargetValue (thresholdDecibels.getTargetValue());
+        inputGain.setCurrentAndTargetValue (inputGain.getTargetValue());
+        outputGain.setCurrentAndTargetValue (outputGain.getTargetValue());
+    }
+
+    /** Moves the threshold and gain ramps on by numSamples, exactly as far as process()
+        would have, for a block the caller skips. Nothing else changes.
+    */
+    void skipRamps (size_t numSamples) noexcept
+    {
+        for (auto* ramp : { &thresholdDecibels, &inputGain, &outputGain })
+            for (size_t i = 0; i < numSamples && ramp->isSmoothing(); ++i)
+                ramp->getNextValue();
+    }
+
+    //==============================================================================
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        process (context, {});
+    }
+
+    /** Processes the main signal, using sidechainBlock as the key in external mode.
+        With an empty sidechain block, external mode falls back to per-channel detection.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const juce::dsp::AudioBlock<const SampleType>& sidechainBlock) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples() == numSamples);
+        jassert (numSamples <= audio.size() && numChannels <= numGroups * numLanes);
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        fillRamps (numSamples);
+        minimumGain = 1;
+
+        if (levelDetection == LevelDetection::rms)
+            prepareRmsWindows();
+
+        const auto useExternalKey = detectorMode == DetectorMode::external && sidechainBlock.getNumChannels() > 0;
+        const auto useMidSide = detectorMode == DetectorMode::midSide && numChannels == 2;
+        const auto isLinked = useExternalKey || detectorMode == DetectorMode::linkedMax || detectorMode == DetectorMode::linkedMean;
+        const auto skipGains = transparentFastPath && isTransparent();
+
+        if (skipGains && context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom (inputBlock);
+
+        if (useExternalKey)
+            computeLinkedGains (sidechainBlock, false, numSamples, skipGains);
+        else if (isLinked)
+            computeLinkedGains (inputBlock, true, numSamples, skipGains);
+
+        for (size_t group = 0; group * numLanes < numChannels; ++group)
+        {
+            const auto firstChannel = group * numLanes;
+            const auto numActive = juce::jmin (numLanes, numChannels - firstChannel);
+
+            // Transparent: the output already is the input, so only the detectors this
+            // group runs itself need to move on
+            if (skipGains && isLinked && isUniformLinkGroup (firstChannel, numActive, useExternalKey))
+                continue;
+
+            interleave (inputBlock, firstChannel, numActive, numSamples, audio.data(), true);
+
+            if (useMidSide)
+                encodeMidSide (numSamples);
+
+            if (skipGains)
+            {
+                detect (group, numSamples);
+                continue;
+            }
+
+            if (isLinked)
+            {
+                fillLinkedGains (group, firstChannel, numActive, numSamples, useExternalKey);
+            }
+            else
+            {
+                detect (group, numSamples);
+                computeGains (numSamples);
+            }
+
+            if (gainReductionMetering)
+                trackMinimumGain (numActive, numSamples);
+
+            applyGains (group, numSamples);
+
+            if (useMidSide)
+                encodeMidSide (numSamples, SampleType (1)); // M + S, M - S
+
+            deinterleave (outputBlock, firstChannel, numActive, numSamples);
+        }
+
+        delayWritePosition = (delayWritePosition + numSamples) % delayCapacity;
+
+        if (levelDetection == LevelDetection::rms)
+        {
+            rmsWritePosition = (rmsWritePosition + numSamples) % rmsCapacity;
+            rmsCount = (rmsCount + numSamples) % rmsWindowLength;
+        }
+    }
+
+private:
+    //==============================================================================
+    void update() noexcept
+    {
+        attackCoefficient = calculateCoefficient (attackTime);
+        releaseCoefficient = calculateCoefficient (releaseTime);
+    }
+
+    void updateLookahead() noexcept
+    {
+        if (delayCapacity == 0)
+            return;
+
+        auto newLookaheadSamples = juce::jlimit ((size_t) 0, delayCapacity - 1,
+                                                 (size_t) juce::jmax (0, juce::roundToInt ((double) lookaheadTime * 0.001 * sampleRate)));
+
+        // The rings aren't written while lookahead is off, so turning it on starts them from silence
+        if (lookaheadSamples == 0 && newLookaheadSamples > 0)
+        {
+            std::fill (delayLines.begin(), delayLines.end(), Vector::expand (0));
+            delayWritePosition = 0;
+        }
+
+        lookaheadSamples = newLookaheadSamples;
+    }
+
+    void updateKeyFilter() noexcept
+    {
+        if (sampleRate <= 0)
+            return;
+
+        // Topology-preserving state variable filter, Q = 1 / sqrt (2)
+        const auto g = std::tan (juce::MathConstants<double>::pi * juce::jlimit (1.0, 0.45 * sampleRate, (double) keyFilterCutoff) / sampleRate);
+        const auto k = juce::MathConstants<double>::sqrt2;
+
+        keyFilterA1 = static_cast<SampleType> (1.0 / (1.0 + g * (g + k)));
+        keyFilterA2 = static_cast<SampleType> (g) * keyFilterA1;
+        keyFilterA3 = static_cast<SampleType> (g) * keyFilterA2;
+        keyFilterK = static_cast<SampleType> (k);
+    }
+
+    // Same one-pole time constant as juce::dsp::BallisticsFilter
+    SampleType calculateCoefficient (SampleType timeMs) const noexcept
+    {
+        return timeMs < static_cast<SampleType> (1.0e-3) ? 0
+                                                         : static_cast<SampleType> (std::exp (-2.0 * juce::MathConstants<double>::pi * 1000.0
+                                                                                             / (sampleRate * (double) timeMs)));
+    }
+
+    void updateRmsWindow() noexcept
+    {
+        if (rmsCapacity == 0)
+            return;
+
+        auto newLength = juce::jlimit ((size_t) 1, rmsCapacity - 1,
+                                       (size_t) juce::jmax (1, juce::roundToInt ((double) rmsWindowTime * 0.001 * sampleRate)));
+
+        resumRms = resumRms || newLength != rmsWindowLength;
+        rmsWindowLength = newLength;
+    }
+
+    void clearRmsWindows() noexcept
+    {
+        std::fill (rmsRings.begin(), rmsRings.end(), Vector::expand (0));
+        std::fill (rmsSums.begin(), rmsSums.end(), Vector::expand (0));
+        std::fill (linkedRmsRings.begin(), linkedRmsRings.end(), SampleType (0));
+        linkedRmsSums.fill (0);
+        rmsWritePosition = 0;
+        rmsCount = 0;
+        clearRms = resumRms = false;
+    }
+
+    // Applies a pending clear or window change before the block runs. A new window length
+    // re-sums the last rmsWindowLength squares from the ring, which always holds the
+    // longest window, so the level carries straight on. Only runs when something changed.
+    void prepareRmsWindows() noexcept
+    {
+        if (clearRms)
+        {
+            clearRmsWindows();
+            return;
+        }
+
+        if (! resumRms)
+            return;
+
+        auto resum = [this] (auto* ring, auto& sum, auto& fresh, auto zero)
+        {
+            sum = zero;
+
+            for (size_t i = 1; i <= rmsWindowLength; ++i)
+                sum += ring[(rmsWritePosition + rmsCapacity - i) % rmsCapacity];
+
+            fresh = zero;
+        };
+
+        for (size_t group = 0; group < numGroups; ++group)
+            resum (rmsRings.data() + group * rmsCapacity, rmsSums[2 * group], rmsSums[2 * group + 1], Vector::expand (0));
+
+        for (size_t linkGroup = 0; linkGroup < (size_t) maximumLinkGroups; ++linkGroup)
+            resum (linkedRmsRings.data() + linkGroup * rmsCapacity, linkedRmsSums[2 * linkGroup], linkedRmsSums[2 * linkGroup + 1], SampleType (0));
+
+        rmsCount = 0;
+        resumRms = false;
+    }
+
+    static Vector clampToZero (Vector value) noexcept             { return Vector::max (value, Vector::expand (0)); }
+    static SampleType clampToZero (SampleType value) noexcept     { return juce::jmax (value, SampleType (0)); }
+
+    // Replaces each square with the mean of the last rmsWindowLength squares, in place. One
+    // add and one subtract on the running sum per sample; the fresh sum covers exactly one
+    // window when it takes over, which wipes out any rounding the running sum picked up.
+    template <typename Value>
+    void computeWindowMeans (Value* squares, Value* ring, Value& sum, Value& fresh, Value zero, size_t numSamples) const noexcept
+    {
+        const auto scale = zero + SampleType (1) / (SampleType) rmsWindowLength;
+        auto writePosition = rmsWritePosition;
+        auto readPosition = (writePosition + rmsCapacity - rmsWindowLength) % rmsCapacity;
+        auto count = rmsCount;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto square = squares[i];
+            sum += square - ring[readPosition];
+            fresh += square;
+            ring[writePosition] = square;
+
+            if (++count == rmsWindowLength)
+            {
+                sum = fresh;
+                fresh = zero;
+                count = 0;
+            }
+
+            if (++writePosition == rmsCapacity)  writePosition = 0;
+            if (++readPosition == rmsCapacity)   readPosition = 0;
+
+            squares[i] = clampToZero (sum * scale);
+        }
+    }
+
+    void resetRamps() noexcept
+    {
+        thresholdDecibels.reset (sampleRate, rampDurationSeconds);
+        inputGain.reset (sampleRate, rampDurationSeconds);
+        outputGain.reset (sampleRate, rampDurationSeconds);
+    }
+
+    static void fillRamp (juce::SmoothedValue<SampleType>& ramp, std::vector<SampleType>& values, size_t numSamples) noexcept
+    {
+        if (! ramp.isSmoothing())
+        {
+            std::fill (values.begin(), values.begin() + (std::ptrdiff_t) numSamples, ramp.getTargetValue());
+            return;
+        }
+
+        for (size_t i = 0; i < numSamples; ++i)
+            values[i] = ramp.getNextValue();
+    }
+
+    // Per-sample values shared by every channel group in this block
+    void fillRamps (size_t numSamples) noexcept
+    {
+        fillRamp (inputGain, inputGains, numSamples);
+        fillRamp (outputGain, outputGains, numSamples);
+
+        if (! thresholdDecibels.isSmoothing())
+        {
+            std::fill (thresholdInverse.begin(), thresholdInverse.begin() + (std::ptrdiff_t) numSamples,
+                       SampleType (1) / juce::Decibels::decibelsToGain (thresholdDecibels.getTargetValue(), SampleType (-200)));
+            return;
+        }
+
+        if (gainMath == GainMath::fast)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+                thresholdInverse[i] = FastGainMath<SampleType>::inverseDecibelsToGain (thresholdDecibels.getNextValue());
+
+            return;
+        }
+
+        for (size_t i = 0; i < numSamples; ++i)
+            thresholdInverse[i] = SampleType (1) / juce::Decibels::decibelsToGain (thresholdDecibels.getNextValue(), SampleType (-200));
+    }
+
+    template <typename BlockType>
+    void interleave (const BlockType& block, size_t firstChannel, size_t numActive, size_t numSamples,
+                     Vector* destination, bool applyInputGain) noexcept
+    {
+        auto* raw = reinterpret_cast<SampleType*> (destination);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            if (lane < numActive)
+            {
+                auto* source = block.getChannelPointer (firstChannel + lane);
+
+                if (applyInputGain)
+                {
+                    for (size_t i = 0; i < numSamples; ++i)
+                        raw[i * numLanes + lane] = source[i] * inputGains[i];
+                }
+                else
+                {
+                    for (size_t i = 0; i < numSamples; ++i)
+                        raw[i * numLanes + lane] = source[i];
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    raw[i * numLanes + lane] = 0;
+            }
+        }
+    }
+
+    template <typename BlockType>
+    void deinterleave (BlockType& block, size_t firstChannel, size_t numActive, size_t numSamples) const noexcept
+    {
+        auto* raw = reinterpret_cast<const SampleType*> (audio.data());
+
+        for (size_t lane = 0; lane < numActive; ++lane)
+        {
+            auto* destination = block.getChannelPointer (firstChannel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                destination[i] = raw[i * numLanes + lane];
+        }
+    }
+
+    // Lanes 0 and 1 hold L and R: (L + R) * scale, (L - R) * scale.
+    // Encoding uses 0.5, decoding back from mid/side uses 1.
+    void encodeMidSide (size_t numSamples, SampleType scale = SampleType (0.5)) noexcept
+    {
+        auto* raw = reinterpret_cast<SampleType*> (audio.data());
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto* frame = raw + i * numLanes;
+            const auto left = frame[0], right = frame[1];
+            frame[0] = (left + right) * scale;
+            frame[1] = (left - right) * scale;
+        }
+    }
+
+    void filterKeys (const Vector* source, Vector* destination, size_t keyGroup, size_t numSamples) noexcept
+    {
+        const auto a1 = Vector::expand (keyFilterA1), a2 = Vector::expand (keyFilterA2), a3 = Vector::expand (keyFilterA3);
+        const auto k = Vector::expand (keyFilterK);
+        auto ic1 = keyFilterState[2 * keyGroup], ic2 = keyFilterState[2 * keyGroup + 1];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto v0 = source[i];
+            const auto v3 = v0 - ic2;
+            const auto v1 = a1 * ic1 + a2 * v3;
+            const auto v2 = ic2 + a2 * ic1 + a3 * v3;
+            ic1 = (v1 + v1) - ic1;
+            ic2 = (v2 + v2) - ic2;
+            destination[i] = v0 - k * v1 - v2;
+        }
+
+        keyFilterState[2 * keyGroup] = ic1;
+        keyFilterState[2 * keyGroup + 1] = ic2;
+    }
+
+    // Ballistics: peak level or windowed mean square with separate attack/release
+    // one-poles, all lanes at once
+    void detect (size_t group, size_t numSamples) noexcept
+    {
+        const Vector* source = audio.data();
+
+        if (keyFilterEnabled)
+        {
+            filterKeys (source, keys.data(), numKeyGroups + group, numSamples);
+            source = keys.data();
+        }
+
+        if (levelDetection == LevelDetection::rms)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+                keys[i] = source[i] * source[i];
+
+            computeWindowMeans (keys.data(), rmsRings.data() + group * rmsCapacity,
+                                rmsSums[2 * group], rmsSums[2 * group + 1], Vector::expand (0), numSamples);
+            source = keys.data();
+        }
+
+        const auto release = Vector::expand (releaseCoefficient);
+        const auto attackMinusRelease = Vector::expand (attackCoefficient - releaseCoefficient);
+        auto envelope = state[group];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto level = Vector::abs (source[i]);
+            const auto coefficient = release + (attackMinusRelease & Vector::greaterThan (level, envelope));
+            envelope = level + coefficient * (envelope - level);
+            envelopes[i] = envelope;
+        }
+
+        state[group] = envelope;
+    }
+
+    int getLinkGroup (size_t channel) const noexcept
+    {
+        return channel < maximumLinkedChannels ? linkGroups[channel] : 0;
+    }
+
+    // Folds the key channels of each link group into one level per sample, then runs a
+    // single envelope and gain computer per group. Leaves the gains (trim included) in
+    // that group's row of linkedLevels, or with envelopeOnly just moves the envelopes on.
+    // An external key is always one group.
+    template <typename BlockType>
+    void computeLinkedGains (const BlockType& keyBlock, bool isMainInput, size_t numSamples, bool envelopeOnly) noexcept
+    {
+        const auto numKeyChannels = keyBlock.getNumChannels();
+        const auto useMean = isMainInput && detectorMode == DetectorMode::linkedMean;
+        const auto useRms = levelDetection == LevelDetection::rms;
+        const auto stride = audio.size();
+        auto* raw = reinterpret_cast<const SampleType*> (keys.data());
+        std::array<size_t, (size_t) maximumLinkGroups> groupSizes {};
+
+        jassert (numKeyChannels <= numKeyGroups * numLanes);
+
+        for (size_t keyGroup = 0; keyGroup * numLanes < numKeyChannels; ++keyGroup)
+        {
+            const auto firstChannel = keyGroup * numLanes;
+            const auto numActive = juce::jmin (numLanes, numKeyChannels - firstChannel);
+            interleave (keyBlock, firstChannel, numActive, numSamples, keys.data(), isMainInput);
+
+            if (keyFilterEnabled)
+                filterKeys (keys.data(), keys.data(), keyGroup, numSamples);
+
+            for (size_t lane = 0; lane < numActive; ++lane)
+            {
+                const auto linkGroup = isMainInput ? getLinkGroup (firstChannel + lane) : 0;
+
+                if (linkGroup == unlinked)
+                    continue;
+
+                auto* levels = linkedLevels.data() + (size_t) linkGroup * stride;
+
+                // Rows are cleared on first use, so unused groups cost nothing
+                if (groupSizes[(size_t) linkGroup]++ == 0)
+                    std::fill (levels, levels + numSamples, SampleType (0));
+
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    const auto sample = raw[i * numLanes + lane];
+                    const auto value = useRms ? sample * sample : std::abs (sample);
+                    levels[i] = useMean ? levels[i] + value : juce::jmax (levels[i], value);
+                }
+            }
+        }
+
+        // RMS: the loudest or mean square of the group, then windowed; the envelope stays a
+        // mean square, so the overshoot is squared too and the exponent halved
+        const auto exponent = (ratioInverse - SampleType (1)) * (useRms ? SampleType (0.5) : SampleType (1));
+        const auto useFastMath = gainMath == GainMath::fast;
+
+        for (size_t linkGroup = 0; linkGroup < groupSizes.size(); ++linkGroup)
+        {
+            if (groupSizes[linkGroup] == 0)
+                continue;
+
+            const auto levelScale = useMean ? SampleType (1) / (SampleType) groupSizes[linkGroup] : SampleType (1);
+            auto* levels = linkedLevels.data() + linkGroup * stride;
+            auto envelope = linkedEnvelopes[linkGroup];
+
+            if (useRms)
+                computeWindowMeans (levels, linkedRmsRings.data() + linkGroup * rmsCapacity,
+                                    linkedRmsSums[2 * linkGroup], linkedRmsSums[2 * linkGroup + 1], SampleType (0), numSamples);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto level = levels[i] * levelScale;
+                const auto coefficient = level > envelope ? attackCoefficient : releaseCoefficient;
+                envelope = level + coefficient * (envelope - level);
+
+                if (envelopeOnly)
+                    continue;
+
+                const auto overshoot = envelope * thresholdInverse[i] * (useRms ? thresholdInverse[i] : SampleType (1));
+                levels[i] = (useFastMath ? computeGain<GainMath::fast> (overshoot, exponent)
+                                         : computeGain<GainMath::exact> (overshoot, exponent)) * outputGains[i];
+            }
+
+            linkedEnvelopes[linkGroup] = envelope;
+        }
+    }
+
+    // Gives every lane of this channel group its link group's gains. The usual case of
+    // one link group per vector is a broadcast; a vector that mixes groups or holds
+    // unlinked channels runs its own detector, then the linked lanes are overwritten.
+    bool isUniformLinkGroup (size_t firstChannel, size_t numActive, bool useExternalKey) const noexcept
+    {
+        const auto firstLinkGroup = useExternalKey ? 0 : getLinkGroup (firstChannel);
+        auto isUniform = firstLinkGroup != unlinked;
+
+        for (size_t lane = 1; lane < numActive && isUniform && ! useExternalKey; ++lane)
+            isUniform = getLinkGroup (firstChannel + lane) == firstLinkGroup;
+
+        return isUniform;
+    }
+
+    void fillLinkedGains (size_t group, size_t firstChannel, size_t numActive, size_t numSamples, bool useExternalKey) noexcept
+    {
+        const auto stride = audio.size();
+        const auto firstLinkGroup = useExternalKey ? 0 : getLinkGroup (firstChannel);
+
+        if (isUniformLinkGroup (firstChannel, numActive, useExternalKey))
+        {
+            const auto* gains = linkedLevels.data() + (size_t) firstLinkGroup * stride;
+
+            for (size_t i = 0; i < numSamples; ++i)
+                envelopes[i] = Vector::expand (gains[i]);
+
+            return;
+        }
+
+        detect (group, numSamples);
+        computeGains (numSamples);
+
+        auto* values = reinterpret_cast<SampleType*> (envelopes.data());
+
+        for (size_t lane = 0; lane < numActive; ++lane)
+        {
+            const auto linkGroup = getLinkGroup (firstChannel + lane);
+
+            if (linkGroup == unlinked)
+                continue;
+
+            const auto* gains = linkedLevels.data() + (size_t) linkGroup * stride;
+
+            for (size_t i = 0; i < numSamples; ++i)
+                values[i * numLanes + lane] = gains[i];
+        }
+    }
+
+    // The gains hold the trim too, so it's divided back out
+    void trackMinimumGain (size_t numActive, size_t numSamples) noexcept
+    {
+        const auto* values = reinterpret_cast<const SampleType*> (envelopes.data());
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            if (outputGains[i] <= SampleType (0))
+                continue;
+
+            for (size_t lane = 0; lane < numActive; ++lane)
+                minimumGain = juce::jmin (minimumGain, values[i * numLanes + lane] / outputGains[i]);
+        }
+    }
+
+    void applyGains (size_t group, size_t numSamples) noexcept
+    {
+        if (lookaheadSamples == 0)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+                audio[i] = audio[i] * envelopes[i];
+
+            return;
+        }
+
+        // Delayed audio path: one write and one read into this group's ring per sample
+        auto* ring = delayLines.data() + group * delayCapacity;
+        auto writePosition = delayWritePosition;
+        auto readPosition = (writePosition + delayCapacity - lookaheadSamples) % delayCapacity;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            ring[writePosition] = audio[i];
+            audio[i] = ring[readPosition] * envelopes[i];
+
+            if (++writePosition == delayCapacity)  writePosition = 0;
+            if (++readPosition == delayCapacity)   readPosition = 0;
+        }
+    }
+
+    void computeGains (size_t numSamples) noexcept
+    {
+        if (gainMath == GainMath::fast)
+            computeGains<GainMath::fast> (numSamples);
+        else
+            computeGains<GainMath::exact> (numSamples);
+    }
+
+    // Turns the envelopes into gains in place: (env / threshold) ^ (1 / ratio - 1) above
+    // threshold, multiplied by the output trim. One loop per tier, so the fast one has
+    // no branches or calls left in it and vectorises across the lanes. RMS envelopes are
+    // mean squares: (ms / threshold^2) ^ ((1 / ratio - 1) / 2) is the same law.
+    template <GainMath tier>
+    void computeGains (size_t numSamples) noexcept
+    {
+        auto* values = reinterpret_cast<SampleType*> (envelopes.data());
+        const auto isMeanSquare = levelDetection == LevelDetection::rms;
+        const auto exponent = (ratioInverse - SampleType (1)) * (isMeanSquare ? SampleType (0.5) : SampleType (1));
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto inverse = thresholdInverse[i] * (isMeanSquare ? thresholdInverse[i] : SampleType (1));
+            const auto trim = outputGains[i];
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                auto& value = values[i * numLanes + lane];
+                value = computeGain<tier> (value * inverse, exponent) * trim;
+            }
+        }
+    }
+
+    template <GainMath tier>
+    static SampleType computeGain (SampleType overshoot, SampleType exponent) noexcept
+    {
+        if constexpr (tier == GainMath::fast)
+            return FastGainMath<SampleType>::computeGain (overshoot, exponent);
+        else
+            return overshoot < SampleType (1) ? SampleType (1) : std::pow (overshoot, exponent);
+    }
+
+    //==============================================================================
+    std::vector<Vector> audio, keys, envelopes, state, delayLines, keyFilterState;
+    std::vector<SampleType> thresholdInverse, inputGains, outputGains, linkedLevels;
+    size_t numGroups = 0, numKeyGroups = 0, delayCapacity = 0, delayWritePosition = 0, lookaheadSamples = 0;
+    std::array<int, maximumLinkedChannels> linkGroups {};
+    std::array<SampleType, (size_t) maximumLinkGroups> linkedEnvelopes {};
+
+    std::vector<Vector> rmsRings, rmsSums;
+    std::vector<SampleType> linkedRmsRings;
+    std::array<SampleType, 2 * (size_t) maximumLinkGroups> linkedRmsSums {};
+    size_t rmsCapacity = 0, rmsWindowLength = 1, rmsWritePosition = 0, rmsCount = 0;
+    LevelDetection levelDetection = LevelDetection::peak;
+    SampleType rmsWindowTime = 50;
+    bool clearRms = false, resumRms = false;
+
+    juce::SmoothedValue<SampleType> thresholdDecibels { 0 }, inputGain { 1 }, outputGain { 1 };
+    SampleType ratioInverse = 1, attackTime = 1, releaseTime = 100, lookaheadTime = 0;
+    SampleType attackCoefficient = 0, releaseCoefficient = 0;
+
+    DetectorMode detectorMode = DetectorMode::channel;
+    GainMath gainMath = GainMath::exact;
+    bool transparentFastPath = true;
+    bool gainReductionMetering = false;
+    SampleType minimumGain = 1;
+    bool keyFilterEnabled = false;
+    SampleType keyFilterCutoff = 80, keyFilterA1 = 0, keyFilterA2 = 0, keyFilterA3 = 0, keyFilterK = 0;
+    double sampleRate = 0.0, rampDurationSeconds = 0.02;
+};